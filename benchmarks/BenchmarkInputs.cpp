@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "BenchmarkInputs.h"
+
+void
+Bench::CountingObserver::newMapItem(std::string_view, int)
+{
+    ++this->events;
+}
+
+void
+Bench::CountingObserver::newScalar(std::string_view)
+{
+    ++this->events;
+}
+
+void
+Bench::CountingObserver::newSequenceItem(int)
+{
+    ++this->events;
+}
+
+std::vector<std::string>
+Bench::listDataFiles()
+{
+    std::vector<std::string> names;
+    for (const auto& entry : std::filesystem::directory_iterator(BENCHMARK_DATA_DIR)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".yml") {
+            names.push_back(entry.path().filename().string());
+        }
+    }
+
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+std::string
+Bench::readDataFile(const std::string& name)
+{
+    std::ifstream input(std::string(BENCHMARK_DATA_DIR) + "/" + name, std::ios_base::binary);
+
+    std::string result;
+    std::string line;
+    while (std::getline(input, line)) {
+        bool marker = line.compare(0, 3, "---") == 0 || line.compare(0, 3, "...") == 0;
+        if (!marker || (line.size() > 3 && line[3] != ' ' && line[3] != '\r')) {
+            result += line;
+            result += '\n';
+        }
+    }
+
+    return result;
+}
+
+std::string
+Bench::makeDeepNesting(size_t size)
+{
+    std::string result;
+    while (result.size() < size) {
+        for (int depth = 0; depth < 32; ++depth) {
+            result += std::string(depth * 2, ' ') + "- level" + std::to_string(depth) + ": value\n";
+        }
+    }
+
+    return result;
+}
+
+std::string
+Bench::makeLongSequence(size_t size)
+{
+    std::string result;
+    for (size_t i = 0; result.size() < size; ++i) {
+        result += "- item : Item " + std::to_string(i) + "\r\n";
+        result += "  quantity: " + std::to_string(i % 100) + "\r\n";
+    }
+
+    return result;
+}
+
+std::string
+Bench::makeLongScalars(size_t size)
+{
+    const std::string value(4096, 'x');
+
+    std::string result;
+    for (size_t i = 0; result.size() < size; ++i) {
+        result += "key" + std::to_string(i) + ": " + value + "   \n";
+    }
+
+    return result;
+}
+
+std::string
+Bench::makeCommentHeavy(size_t size)
+{
+    std::string result;
+    for (size_t i = 0; result.size() < size; ++i) {
+        result += "# This line is a comment describing the next key in some detail\n";
+        result += "hr: " + std::to_string(i) + " # Home runs, with a trailing comment\n";
+    }
+
+    return result;
+}
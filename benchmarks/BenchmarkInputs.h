@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "AbstractEventViewObserver.h"
+
+namespace Bench {
+
+class CountingObserver : public YAML::AbstractEventViewObserver {
+public:
+    void newMapItem(std::string_view name, int spaces) override;
+    void newScalar(std::string_view scalar) override;
+    void newSequenceItem(int spaces) override;
+public:
+    size_t events = 0;
+};
+
+// Names of the .yml files in the test data directory, sorted
+std::vector<std::string> listDataFiles();
+
+// Reads a test data file without its "---" and "..." document markers,
+// which the parser does not accept
+std::string readDataFile(const std::string& name);
+
+// Generated documents of roughly the requested size in bytes
+std::string makeDeepNesting(size_t size);
+std::string makeLongSequence(size_t size);
+std::string makeLongScalars(size_t size);
+std::string makeCommentHeavy(size_t size);
+
+}
@@ -0,0 +1,215 @@
+#include <benchmark/benchmark.h>
+#include <functional>
+#include <sstream>
+
+#include "BasicParser.h"
+#include "BenchmarkInputs.h"
+#include "LineParser.h"
+#include "ParallelParser.h"
+#include "Parser.h"
+
+namespace {
+
+const size_t GeneratedSize = 16 * 1024 * 1024;
+
+// Non-virtual counterpart of Bench::CountingObserver for BasicParser
+struct InlineCountingObserver {
+    void newMapItem(std::string_view, int) {
+        ++this->events;
+    }
+
+    void newScalar(std::string_view) {
+        ++this->events;
+    }
+
+    void newSequenceItem(int) {
+        ++this->events;
+    }
+
+    size_t events = 0;
+};
+
+void
+setCounters(benchmark::State& state, size_t bytes, size_t events)
+{
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+    state.counters["events"] = benchmark::Counter(static_cast<double>(state.iterations() * events),
+            benchmark::Counter::kIsRate);
+}
+
+void
+parseBuffer(benchmark::State& state, const std::string& input)
+{
+    size_t events = 0;
+    for (auto _ : state) {
+        Bench::CountingObserver observer;
+        YAML::Parser parser(&observer);
+        if (!parser.parse(input.data(), input.size())) {
+            state.SkipWithError("parse failed");
+            break;
+        }
+
+        events = observer.events;
+    }
+
+    setCounters(state, input.size(), events);
+}
+
+void
+parseBasic(benchmark::State& state, const std::string& input)
+{
+    size_t events = 0;
+    for (auto _ : state) {
+        InlineCountingObserver observer;
+        YAML::BasicParser<InlineCountingObserver> parser(&observer);
+        if (!parser.parse(input.data(), input.size())) {
+            state.SkipWithError("parse failed");
+            break;
+        }
+
+        events = observer.events;
+    }
+
+    setCounters(state, input.size(), events);
+}
+
+void
+validate(benchmark::State& state, const std::string& input)
+{
+    for (auto _ : state) {
+        YAML::SyntaxValidator validator;
+        if (!validator.parse(input.data(), input.size())) {
+            state.SkipWithError("parse failed");
+            break;
+        }
+    }
+
+    setCounters(state, input.size(), 0);
+}
+
+void
+parseStream(benchmark::State& state, const std::string& input)
+{
+    size_t events = 0;
+    for (auto _ : state) {
+        std::stringstream stream(input);
+        Bench::CountingObserver observer;
+        YAML::Parser parser(&observer);
+        if (!parser.parse(stream)) {
+            state.SkipWithError("parse failed");
+            break;
+        }
+
+        events = observer.events;
+    }
+
+    setCounters(state, input.size(), events);
+}
+
+void
+parseLines(benchmark::State& state, const std::string& input)
+{
+    size_t events = 0;
+    for (auto _ : state) {
+        Bench::CountingObserver observer;
+        YAML::LineParser lineParser(&observer);
+
+        bool result = true;
+        size_t begin = 0;
+        while (result && begin < input.size()) {
+            size_t end = input.find('\n', begin);
+            if (end == std::string::npos) {
+                end = input.size();
+            }
+
+            result = lineParser.parse(input.data() + begin, end - begin);
+            begin = end + 1;
+        }
+
+        if (!result || !lineParser.finish()) {
+            state.SkipWithError("parse failed");
+            break;
+        }
+
+        events = observer.events;
+    }
+
+    setCounters(state, input.size(), events);
+}
+
+void
+parseParallel(benchmark::State& state, const std::string& input)
+{
+    size_t events = 0;
+    for (auto _ : state) {
+        Bench::CountingObserver observer;
+        YAML::ParallelParser parser(&observer, static_cast<unsigned>(state.range(0)), 1024 * 1024);
+        if (!parser.parse(input.data(), input.size())) {
+            state.SkipWithError("parse failed");
+            break;
+        }
+
+        events = observer.events;
+    }
+
+    setCounters(state, input.size(), events);
+}
+
+using InputFactory = std::function<std::string()>;
+using Runner = void (*)(benchmark::State&, const std::string&);
+
+void
+registerInput(const std::string& name, InputFactory factory)
+{
+    // Inputs are created lazily so filtered runs do not pay for them
+    auto input = std::make_shared<std::string>();
+    auto load = [input, factory]() -> const std::string& {
+        if (input->empty()) {
+            *input = factory();
+        }
+
+        return *input;
+    };
+
+    const std::pair<const char *, Runner> runners[] = {
+        {"Parser/buffer/", parseBuffer},
+        {"Parser/stream/", parseStream},
+        {"BasicParser/buffer/", parseBasic},
+        {"SyntaxValidator/", validate},
+        {"LineParser/", parseLines},
+    };
+
+    for (const auto& runner : runners) {
+        Runner run = runner.second;
+        benchmark::RegisterBenchmark((runner.first + name).c_str(),
+                [load, run](benchmark::State& state) { run(state, load()); });
+    }
+}
+
+bool
+registerBenchmarks()
+{
+    for (const std::string& file : Bench::listDataFiles()) {
+        registerInput(file, [file]() { return Bench::readDataFile(file); });
+    }
+
+    registerInput("deep-nesting", []() { return Bench::makeDeepNesting(GeneratedSize); });
+    registerInput("long-sequence", []() { return Bench::makeLongSequence(GeneratedSize); });
+    registerInput("long-scalars", []() { return Bench::makeLongScalars(GeneratedSize); });
+    registerInput("comment-heavy", []() { return Bench::makeCommentHeavy(GeneratedSize); });
+
+    auto sequence = std::make_shared<std::string>();
+    benchmark::RegisterBenchmark("ParallelParser/long-sequence", [sequence](benchmark::State& state) {
+        if (sequence->empty()) {
+            *sequence = Bench::makeLongSequence(GeneratedSize * 4);
+        }
+
+        parseParallel(state, *sequence);
+    })->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
+    return true;
+}
+
+const bool registered = registerBenchmarks();
+
+}
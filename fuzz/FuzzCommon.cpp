@@ -0,0 +1,57 @@
+#include <cstdio>
+#include <cstdlib>
+
+#include "FuzzCommon.h"
+
+void
+Fuzz::EventRecorder::newMapItem(std::string_view name, int spaces)
+{
+    this->events.push_back("M" + std::to_string(spaces) + ":" + std::string(name));
+}
+
+void
+Fuzz::EventRecorder::newScalar(std::string_view scalar)
+{
+    this->events.push_back("S:" + std::string(scalar));
+}
+
+void
+Fuzz::EventRecorder::newSequenceItem(int spaces)
+{
+    this->events.push_back("Q" + std::to_string(spaces));
+}
+
+Fuzz::LinearTimeCheck::LinearTimeCheck(size_t size)
+    : size(size),
+      start(std::chrono::steady_clock::now())
+{
+}
+
+Fuzz::LinearTimeCheck::~LinearTimeCheck()
+{
+    if (this->size < MinimumSize) {
+        return;
+    }
+
+    double bound = DefaultNanosecondsPerByte;
+    if (const char *value = std::getenv("YAML_FUZZ_NS_PER_BYTE")) {
+        bound = std::atof(value);
+    }
+
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - this->start;
+    double perByte = elapsed.count() / static_cast<double>(this->size);
+    if (bound > 0.0 && perByte > bound) {
+        std::fprintf(stderr, "parse took %g ns per byte for %zu bytes (bound %g)\n",
+                perByte, this->size, bound);
+        std::abort();
+    }
+}
+
+void
+Fuzz::check(bool condition, const char *message)
+{
+    if (!condition) {
+        std::fprintf(stderr, "%s\n", message);
+        std::abort();
+    }
+}
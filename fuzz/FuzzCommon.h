@@ -0,0 +1,42 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "AbstractEventViewObserver.h"
+
+namespace Fuzz {
+
+// Copies every event so runs over different inputs can be compared
+class EventRecorder : public YAML::AbstractEventViewObserver {
+public:
+    void newMapItem(std::string_view name, int spaces) override;
+    void newScalar(std::string_view scalar) override;
+    void newSequenceItem(int spaces) override;
+public:
+    std::vector<std::string> events;
+};
+
+// Aborts when the parse took longer per byte than the bound, so inputs that
+// make parsing superlinear are reported as crashes. The bound in
+// nanoseconds per byte is read from YAML_FUZZ_NS_PER_BYTE; short inputs
+// are not timed since fixed costs dominate them.
+class LinearTimeCheck {
+public:
+    static constexpr size_t MinimumSize = 4096;
+    static constexpr double DefaultNanosecondsPerByte = 2000.0;
+public:
+    LinearTimeCheck(size_t size);
+    ~LinearTimeCheck();
+private:
+    size_t size = 0;
+    std::chrono::steady_clock::time_point start;
+};
+
+// Aborts with message when condition does not hold
+void check(bool condition, const char *message);
+
+}
@@ -0,0 +1,31 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "FuzzCommon.h"
+#include "LineParser.h"
+
+// Feeds the input to LineParser line by line, continuing after failures,
+// which exercises state carried over from failed lines.
+extern "C" int
+LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    const char *input = reinterpret_cast<const char *>(data);
+    const char *end = input + size;
+
+    Fuzz::LinearTimeCheck timeCheck(size);
+
+    Fuzz::EventRecorder events;
+    YAML::LineParser lineParser(&events);
+    while (input != end) {
+        const char *lineEnd = static_cast<const char *>(std::memchr(input, '\n', end - input));
+        if (lineEnd == nullptr) {
+            lineEnd = end;
+        }
+
+        lineParser.parse(input, lineEnd - input);
+        input = lineEnd != end ? lineEnd + 1 : end;
+    }
+
+    return 0;
+}
@@ -0,0 +1,47 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+#include "FuzzCommon.h"
+#include "Parser.h"
+
+// Parses the input as one buffer, as a stream and in fed fragments. All
+// three must agree on the result and the events, and the buffer parse must
+// stay linear in the input size.
+extern "C" int
+LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    const char *input = reinterpret_cast<const char *>(data);
+
+    Fuzz::EventRecorder bufferEvents;
+    bool bufferResult = false;
+    {
+        Fuzz::LinearTimeCheck timeCheck(size);
+        YAML::Parser parser(&bufferEvents);
+        bufferResult = parser.parse(input, size);
+    }
+
+    Fuzz::EventRecorder streamEvents;
+    std::stringstream stream(std::string(input, size));
+    YAML::Parser streamParser(&streamEvents);
+    bool streamResult = streamParser.parse(stream);
+
+    Fuzz::check(bufferResult == streamResult, "buffer and stream results differ");
+    Fuzz::check(bufferEvents.events == streamEvents.events, "buffer and stream events differ");
+
+    // The first byte picks the fragment size
+    size_t fragmentSize = size != 0 ? data[0] % 16 + 1 : 1;
+    Fuzz::EventRecorder feedEvents;
+    YAML::Parser pushParser(&feedEvents);
+    bool feedResult = true;
+    for (size_t offset = 0; feedResult && offset < size; offset += fragmentSize) {
+        feedResult = pushParser.feed(input + offset, std::min(fragmentSize, size - offset));
+    }
+    feedResult = pushParser.finish() && feedResult;
+
+    Fuzz::check(bufferResult == feedResult, "buffer and feed results differ");
+    Fuzz::check(bufferEvents.events == feedEvents.events, "buffer and feed events differ");
+    return 0;
+}
@@ -0,0 +1,57 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+namespace {
+
+int
+replay(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::fprintf(stderr, "cannot open %s\n", path.string().c_str());
+        return 1;
+    }
+
+    std::vector<char> input((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t *>(input.data()), input.size());
+    return 0;
+}
+
+}
+
+// Stand-in for the libFuzzer driver on compilers without it: runs every
+// file and every file in the directories given, ignoring libFuzzer flags.
+int
+main(int argc, char **argv)
+{
+    int result = 0;
+    size_t count = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (argv[i][0] == '-') {
+            continue;
+        }
+
+        std::filesystem::path path(argv[i]);
+        if (std::filesystem::is_directory(path)) {
+            for (const auto& entry : std::filesystem::directory_iterator(path)) {
+                result |= replay(entry.path());
+                ++count;
+            }
+        } else {
+            result |= replay(path);
+            ++count;
+        }
+    }
+
+    std::printf("replayed %zu inputs\n", count);
+    return result;
+}
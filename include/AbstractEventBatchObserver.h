@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace YAML {
+
+// Compact form of one parse event. Text is referenced by offset and length
+// from the base pointer of the batch; sequence items carry no text.
+struct EventRecord {
+    enum class Kind : uint8_t {
+        MapItem,
+        Scalar,
+        SequenceItem,
+    };
+
+    uint64_t offset;
+    uint32_t length;
+    int32_t spaces;
+    Kind kind;
+};
+
+class AbstractEventBatchObserver {
+public:
+    virtual ~AbstractEventBatchObserver() = default;
+
+    // base is only guaranteed to be valid during the call
+    virtual void newEvents(const char *base, const EventRecord *records, size_t count) = 0;
+};
+
+}
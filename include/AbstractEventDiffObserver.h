@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace YAML {
+
+// A parse event with its own copy of the text
+struct ParsedEvent {
+    enum class Type {
+        MapItem,
+        Scalar,
+        SequenceItem,
+    };
+
+    Type type;
+    std::string value;
+    // Indentation of map and sequence items; 0 for scalars
+    int spaces;
+
+    bool operator==(const ParsedEvent& other) const {
+        return this->type == other.type && this->spaces == other.spaces && this->value == other.value;
+    }
+
+    bool operator!=(const ParsedEvent& other) const {
+        return !(*this == other);
+    }
+};
+
+// Receives the difference between the event sequences of two versions of
+// a document. Each index is a position in the old sequence with all the
+// changes reported before it applied, so replaying them in order turns the
+// old sequence into the new one.
+class AbstractEventDiffObserver {
+public:
+    virtual ~AbstractEventDiffObserver() = default;
+
+    virtual void eventAdded(size_t index, const ParsedEvent& event) = 0;
+    virtual void eventRemoved(size_t index, const ParsedEvent& event) = 0;
+    virtual void eventChanged(size_t index, const ParsedEvent& before, const ParsedEvent& after) = 0;
+};
+
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <string_view>
+
+namespace YAML {
+
+class AbstractEventViewObserver {
+public:
+    virtual ~AbstractEventViewObserver() = default;
+
+    virtual void newMapItem(std::string_view name, int spaces) = 0;
+    virtual void newScalar(std::string_view scalar) = 0;
+    virtual void newSequenceItem(int spaces) = 0;
+};
+
+}
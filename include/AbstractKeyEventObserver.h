@@ -0,0 +1,20 @@
+#pragma once
+
+#include <string_view>
+
+#include "KeyTable.h"
+
+namespace YAML {
+
+// Event observer that receives map keys interned in a KeyTable. A key the
+// table could not hold arrives with id KeyTable::NoId and is not stable.
+class AbstractKeyEventObserver {
+public:
+    virtual ~AbstractKeyEventObserver() = default;
+
+    virtual void newMapItem(const KeyTable::Key& key, int spaces) = 0;
+    virtual void newScalar(std::string_view scalar) = 0;
+    virtual void newSequenceItem(int spaces) = 0;
+};
+
+}
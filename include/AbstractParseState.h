@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+
+namespace YAML {
+
+class AbstractParseState {
+public:
+    enum class State {
+        Init,
+        Scalar,
+        ComplexScalar,
+        SequenceScalar,
+        Spaces,
+        Map,
+        Sequence,
+        Comments,
+        BlockScalar,
+        FlowCollection,
+        Error,
+    };
+
+    static constexpr size_t StateCount = static_cast<size_t>(State::Error) + 1;
+};
+
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string_view>
+
+namespace YAML {
+
+// Optional interface for event observers: an observer that also implements
+// it receives the value of each block scalar (| and >) in pieces instead of
+// one newScalar call, so a large value is never joined into one string.
+// Pieces point into the input lines and are only valid during the call.
+class AbstractScalarChunkObserver {
+public:
+    virtual ~AbstractScalarChunkObserver() = default;
+
+    // The last call for a value has last set and may have an empty chunk
+    virtual void newScalarChunk(std::string_view chunk, bool last) = 0;
+};
+
+}
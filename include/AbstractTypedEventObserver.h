@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string_view>
+
+#include "ScalarValue.h"
+
+namespace YAML {
+
+// Event observer that receives scalars already classified and converted
+class AbstractTypedEventObserver {
+public:
+    virtual ~AbstractTypedEventObserver() = default;
+
+    virtual void newMapItem(std::string_view name, int spaces) = 0;
+    virtual void newScalar(const ScalarValue& scalar) = 0;
+    virtual void newSequenceItem(int spaces) = 0;
+};
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace YAML {
+
+// Bump allocator: objects are carved out of large blocks and released all
+// at once when the arena is cleared or destroyed. Only trivially
+// destructible objects may live here.
+class Arena {
+public:
+    static constexpr size_t DefaultBlockSize = 64 * 1024;
+public:
+    Arena(size_t blockSize = DefaultBlockSize);
+    Arena(const Arena&) = delete;
+    Arena(Arena&& other) noexcept;
+    ~Arena();
+
+    Arena& operator=(const Arena&) = delete;
+    Arena& operator=(Arena&& other) noexcept;
+
+    void *allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    std::string_view copy(std::string_view value);
+
+    template <typename T, typename... Args>
+    T *create(Args&&... args) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                "Arena never runs destructors");
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    // Releases everything but the most recent block, which is kept for reuse
+    void clear();
+
+    size_t getAllocatedSize() const;
+private:
+    struct Block {
+        Block *next;
+        size_t size;
+    };
+private:
+    void release(Block *block);
+    void swap(Arena& other) noexcept;
+private:
+    Block *head = nullptr;
+    char *current = nullptr;
+    char *end = nullptr;
+    size_t blockSize = DefaultBlockSize;
+    size_t allocatedSize = 0;
+};
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "Parser.h"
+
+namespace YAML {
+
+class AbstractEventObserver;
+class AbstractEventViewObserver;
+
+// Parses a file while a reader thread fetches the blocks ahead of the one
+// being parsed, so I/O on a cold page cache overlaps with parsing. Blocks
+// go through Parser::feed, which carries lines spanning two blocks over.
+class AsyncFileParser {
+public:
+    static constexpr size_t DefaultBlockSize = 1024 * 1024;
+    static constexpr size_t DefaultBlockCount = 4;
+public:
+    AsyncFileParser(AbstractEventObserver *eventObserver, size_t blockSize = DefaultBlockSize,
+            size_t blockCount = DefaultBlockCount);
+    AsyncFileParser(AbstractEventViewObserver *eventObserver, size_t blockSize = DefaultBlockSize,
+            size_t blockCount = DefaultBlockCount);
+
+    // False when the file cannot be read or does not parse
+    bool parseFile(const std::string& path);
+
+    const ParseError& getError() const;
+private:
+    Parser parser;
+    size_t blockSize = DefaultBlockSize;
+    size_t blockCount = DefaultBlockCount;
+};
+
+}
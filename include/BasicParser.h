@@ -0,0 +1,368 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <istream>
+#include <string>
+
+#include "AbstractEventViewObserver.h"
+#include "MappedFile.h"
+#include "ParseError.h"
+#include "ParseStateMachine.h"
+#include "StructuralIndex.h"
+
+namespace YAML {
+
+// Parser specialized for one observer type. Observer needs newMapItem,
+// newScalar and newSequenceItem taking the same arguments as
+// AbstractEventViewObserver; NullObserver checks syntax only. Statistics is
+// NoStatistics, which compiles away, or ParseStatistics.
+template <typename Observer, typename Statistics = NoStatistics>
+class BasicParser {
+public:
+    BasicParser(Observer *eventObserver = nullptr);
+
+    bool parse(std::istream& input);
+    bool parse(const char *data, size_t length);
+    bool parseFile(const std::string& path);
+
+    // Incremental parsing: events for each line are emitted as soon as the
+    // line is complete, those of a block scalar with the line after it; at
+    // most one partial line is buffered between calls.
+    bool feed(const char *data, size_t length);
+    bool finish();
+
+    // Feeds the last piece of the input and finishes. Unless a partial line
+    // is still buffered, its lines are parsed in place, so events of the
+    // unterminated last line point into data as they do with parse().
+    bool finish(const char *data, size_t length);
+
+    bool isIdle() const;
+
+    // Returns to the initial state without releasing buffer capacity, so a
+    // reused parser does not allocate once its buffers have grown
+    void reset();
+
+    Statistics& getStatistics();
+    const Statistics& getStatistics() const;
+
+    // Where the last failed parse stopped; valid after a parse, feed or
+    // finish call returned false
+    const ParseError& getError() const;
+private:
+    bool parseLine(const char *data, size_t length, const StructuralIndex *index = nullptr);
+
+    // Fills error from the position the state machine recorded
+    void setError(const char *lineBegin);
+
+    // Parses the complete lines of [data, end) and returns the start of the
+    // unterminated last line, or nullptr when a line fails
+    const char *parseLines(const char *data, const char *end);
+
+    // Ends the input at offset; a flow collection still open is reported
+    // there
+    bool finishInput(size_t offset);
+private:
+    ParseStateMachine<Observer, Statistics> stateMachine;
+    StructuralIndex index;
+    std::string line;
+    std::string pending;
+    bool failed = false;
+
+    // Lines completed so far, and the input offset of base; the line and
+    // offset of an error are derived from these only when it happens
+    ParseError error;
+    const char *base = nullptr;
+    size_t baseOffset = 0;
+    size_t lineNumber = 0;
+    size_t fedBytes = 0;
+};
+
+using SyntaxValidator = BasicParser<NullObserver>;
+using InstrumentedParser = BasicParser<AbstractEventViewObserver, ParseStatistics>;
+
+template <typename Observer, typename Statistics>
+BasicParser<Observer, Statistics>::BasicParser(Observer *eventObserver)
+    : stateMachine(eventObserver)
+{
+}
+
+template <typename Observer, typename Statistics>
+bool
+BasicParser<Observer, Statistics>::parse(std::istream& input)
+{
+    typename Statistics::Timer timer(getStatistics(), ParsePhase::Lines);
+
+    this->lineNumber = 0;
+
+    bool result = true;
+    size_t offset = 0;
+    while (result && std::getline(input, this->line)) {
+        this->base = this->line.data();
+        this->baseOffset = offset;
+        result = parseLine(this->line.data(), this->line.size());
+
+        // getline stops at the end of the input when the last line is not
+        // terminated
+        offset += this->line.size() + (input.eof() ? 0 : 1);
+    }
+
+    return result && finishInput(offset) && !input.bad() && input.eof();
+}
+
+template <typename Observer, typename Statistics>
+bool
+BasicParser<Observer, Statistics>::parse(const char *data, size_t length)
+{
+    this->base = data;
+    this->baseOffset = 0;
+    this->lineNumber = 0;
+    if (length == 0) {
+        return finishInput(0);
+    }
+
+    const char *end = data + length;
+    const char *tail = parseLines(data, end);
+    if (tail == nullptr) {
+        return false;
+    }
+
+    typename Statistics::Timer timer(getStatistics(), ParsePhase::Lines);
+    if (tail != end && !parseLine(tail, end - tail, &this->index)) {
+        return false;
+    }
+
+    return finishInput(length);
+}
+
+template <typename Observer, typename Statistics>
+bool
+BasicParser<Observer, Statistics>::parseFile(const std::string& path)
+{
+    MappedFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+
+    return parse(file.getData(), file.getSize());
+}
+
+template <typename Observer, typename Statistics>
+bool
+BasicParser<Observer, Statistics>::feed(const char *data, size_t length)
+{
+    if (this->failed) {
+        return false;
+    }
+
+    if (length == 0) {
+        return true;
+    }
+
+    const char *end = data + length;
+    const char *chunk = data;
+    size_t offset = this->fedBytes;
+    this->fedBytes += length;
+
+    if (!this->pending.empty()) {
+        const char *lineEnd = static_cast<const char *>(std::memchr(data, '\n', length));
+        if (lineEnd == nullptr) {
+            this->pending.append(data, length);
+            return true;
+        }
+
+        this->baseOffset = offset - this->pending.size();
+        this->pending.append(data, lineEnd);
+        this->base = this->pending.data();
+
+        typename Statistics::Timer timer(getStatistics(), ParsePhase::Lines);
+        this->failed = !parseLine(this->pending.data(), this->pending.size());
+        this->pending.clear();
+        data = lineEnd + 1;
+    }
+
+    this->base = chunk;
+    this->baseOffset = offset;
+
+    const char *tail = this->failed ? nullptr : parseLines(data, end);
+    if (tail == nullptr) {
+        this->failed = true;
+        return false;
+    }
+
+    this->pending.assign(tail, end);
+    return true;
+}
+
+template <typename Observer, typename Statistics>
+bool
+BasicParser<Observer, Statistics>::finish()
+{
+    this->base = this->pending.data();
+    this->baseOffset = this->fedBytes - this->pending.size();
+
+    typename Statistics::Timer timer(getStatistics(), ParsePhase::Lines);
+    bool result = !this->failed &&
+        (this->pending.empty() || parseLine(this->pending.data(), this->pending.size())) &&
+        finishInput(this->fedBytes);
+
+    this->pending.clear();
+    this->failed = false;
+    this->lineNumber = 0;
+    this->fedBytes = 0;
+    return result;
+}
+
+template <typename Observer, typename Statistics>
+bool
+BasicParser<Observer, Statistics>::finish(const char *data, size_t length)
+{
+    if (!this->pending.empty()) {
+        bool result = feed(data, length);
+        return finish() && result;
+    }
+
+    this->base = data;
+    this->baseOffset = this->fedBytes;
+    this->fedBytes += length;
+
+    const char *end = data + length;
+    const char *tail = this->failed ? nullptr : parseLines(data, end);
+    if (tail == nullptr) {
+        this->failed = true;
+    } else if (tail != end) {
+        typename Statistics::Timer timer(getStatistics(), ParsePhase::Lines);
+        this->failed = !parseLine(tail, end - tail, &this->index);
+    }
+
+    return finish();
+}
+
+template <typename Observer, typename Statistics>
+bool
+BasicParser<Observer, Statistics>::isIdle() const
+{
+    return this->stateMachine.isIdle();
+}
+
+template <typename Observer, typename Statistics>
+void
+BasicParser<Observer, Statistics>::reset()
+{
+    this->stateMachine.reset();
+    this->line.clear();
+    this->pending.clear();
+    this->failed = false;
+    this->error = ParseError();
+    this->lineNumber = 0;
+    this->fedBytes = 0;
+}
+
+template <typename Observer, typename Statistics>
+Statistics&
+BasicParser<Observer, Statistics>::getStatistics()
+{
+    return this->stateMachine.getStatistics();
+}
+
+template <typename Observer, typename Statistics>
+const Statistics&
+BasicParser<Observer, Statistics>::getStatistics() const
+{
+    return this->stateMachine.getStatistics();
+}
+
+template <typename Observer, typename Statistics>
+const ParseError&
+BasicParser<Observer, Statistics>::getError() const
+{
+    return this->error;
+}
+
+template <typename Observer, typename Statistics>
+bool
+BasicParser<Observer, Statistics>::parseLine(const char *data, size_t length, const StructuralIndex *index)
+{
+    getStatistics().addLine(length);
+
+    InputBuffer input(data, length, index);
+    if (!this->stateMachine.parse(input)) {
+        setError(data);
+        return false;
+    }
+
+    ++this->lineNumber;
+    return true;
+}
+
+template <typename Observer, typename Statistics>
+void
+BasicParser<Observer, Statistics>::setError(const char *lineBegin)
+{
+    const char *position = this->stateMachine.getErrorPosition();
+    if (position == nullptr) {
+        position = lineBegin;
+    }
+
+    this->error.line = this->lineNumber + 1;
+    this->error.column = static_cast<size_t>(position - lineBegin) + 1;
+    this->error.offset = this->baseOffset + static_cast<size_t>(position - this->base);
+    this->error.state = this->stateMachine.getErrorState();
+    this->stateMachine.clearError();
+}
+
+template <typename Observer, typename Statistics>
+bool
+BasicParser<Observer, Statistics>::finishInput(size_t offset)
+{
+    if (this->stateMachine.finish()) {
+        return true;
+    }
+
+    this->error.line = this->lineNumber + 1;
+    this->error.column = 1;
+    this->error.offset = offset;
+    this->error.state = this->stateMachine.getErrorState();
+    return false;
+}
+
+template <typename Observer, typename Statistics>
+const char *
+BasicParser<Observer, Statistics>::parseLines(const char *data, const char *end)
+{
+    // The structural index is built for a window of the input at a time so
+    // it stays cache resident; a window grows when a single line does not
+    // fit in it.
+    const size_t defaultWindowSize = 64 * 1024;
+
+    size_t windowSize = defaultWindowSize;
+    while (data != end) {
+        const char *windowBegin = data;
+        const char *windowEnd = data + std::min(windowSize, static_cast<size_t>(end - data));
+        {
+            typename Statistics::Timer timer(getStatistics(), ParsePhase::Index);
+            this->index.build(windowBegin, windowEnd);
+        }
+
+        typename Statistics::Timer timer(getStatistics(), ParsePhase::Lines);
+        const char *lineEnd = nullptr;
+        while ((lineEnd = this->index.find(data, windowEnd, StructuralIndex::Newline)) != windowEnd) {
+            if (!parseLine(data, lineEnd - data, &this->index)) {
+                return nullptr;
+            }
+
+            data = lineEnd + 1;
+        }
+
+        if (windowEnd == end) {
+            break;
+        }
+
+        windowSize = data == windowBegin ? windowSize * 2 : defaultWindowSize;
+    }
+
+    return data;
+}
+
+}
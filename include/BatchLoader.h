@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Document.h"
+#include "DocumentBuilder.h"
+#include "ParseError.h"
+
+namespace YAML {
+
+// Loads many independent documents at once on a work-stealing thread pool.
+// Results are returned in input order.
+class BatchLoader {
+public:
+    enum class Status {
+        Ok,
+        OpenFailed,
+        ParseFailed,
+    };
+
+    struct Result {
+        Status status = Status::Ok;
+        // Set when status is ParseFailed
+        ParseError error;
+        Document document;
+    };
+public:
+    BatchLoader(unsigned threads = 0);
+
+    std::vector<Result> loadFiles(const std::vector<std::string>& paths);
+
+    // With Strings::Reference the buffers must outlive the documents
+    std::vector<Result> loadBuffers(const std::vector<std::string_view>& buffers,
+            DocumentBuilder::Strings strings = DocumentBuilder::Strings::Copy);
+private:
+    // Calls load(worker, index) for every input, each worker reusing one
+    // parser for all the inputs it takes
+    template <typename Load>
+    void run(size_t count, DocumentBuilder::Strings strings, Load load);
+private:
+    unsigned threads = 1;
+};
+
+}
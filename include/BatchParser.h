@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "AbstractEventBatchObserver.h"
+#include "AbstractScalarChunkObserver.h"
+#include "BasicParser.h"
+
+namespace YAML {
+
+// Observer for BasicParser that packs events into EventRecords and hands
+// them to an AbstractEventBatchObserver batchSize records at a time. Block
+// scalars are not contiguous in the parsed buffer; each is joined and
+// delivered in a batch of its own.
+class EventBatcher : public AbstractScalarChunkObserver {
+public:
+    EventBatcher(AbstractEventBatchObserver *eventObserver, size_t batchSize);
+
+    // Start of the buffer event text is taken from; pending records are
+    // flushed first
+    void setBase(const char *base);
+    void flush();
+
+    void newMapItem(std::string_view name, int spaces) {
+        add(EventRecord::Kind::MapItem, name, spaces);
+    }
+
+    void newScalar(std::string_view scalar) {
+        add(EventRecord::Kind::Scalar, scalar, 0);
+    }
+
+    void newSequenceItem(int spaces) {
+        add(EventRecord::Kind::SequenceItem, std::string_view(), spaces);
+    }
+
+    void newScalarChunk(std::string_view chunk, bool last) override;
+private:
+    void add(EventRecord::Kind kind, std::string_view text, int spaces) {
+        EventRecord record;
+        record.offset = text.empty() ? 0 : static_cast<uint64_t>(text.data() - this->base);
+        record.length = static_cast<uint32_t>(text.size());
+        record.spaces = spaces;
+        record.kind = kind;
+        this->records.push_back(record);
+
+        if (this->records.size() == this->batchSize) {
+            flush();
+        }
+    }
+private:
+    AbstractEventBatchObserver *eventObserver = nullptr;
+    size_t batchSize = 0;
+    const char *base = nullptr;
+    std::vector<EventRecord> records;
+    std::string blockScalar;
+};
+
+// Parses buffers and delivers their events in batches instead of one
+// virtual call per event.
+class BatchParser {
+public:
+    static constexpr size_t DefaultBatchSize = 1024;
+public:
+    BatchParser(AbstractEventBatchObserver *eventObserver, size_t batchSize = DefaultBatchSize);
+
+    // The parser keeps a pointer to its own batcher
+    BatchParser(const BatchParser&) = delete;
+    BatchParser& operator=(const BatchParser&) = delete;
+
+    bool parse(const char *data, size_t length);
+    bool parseFile(const std::string& path);
+private:
+    EventBatcher batcher;
+    BasicParser<EventBatcher> parser;
+};
+
+}
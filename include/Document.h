@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include "Arena.h"
+#include "ScalarValue.h"
+
+namespace YAML {
+
+class Node {
+public:
+    enum class Type {
+        Null,
+        Scalar,
+        Map,
+        Sequence,
+    };
+public:
+    Type getType() const;
+    bool isNull() const;
+    bool isScalar() const;
+    bool isMap() const;
+    bool isSequence() const;
+
+    // Key of this node inside its parent map, empty for sequence items
+    std::string_view getKey() const;
+    // Scalar text; for a map or sequence, a scalar given on its key line
+    std::string_view getValue() const;
+    // The value classified as null, bool, integer, float or string
+    ScalarValue getScalarValue() const;
+
+    size_t size() const;
+    const Node *getFirstChild() const;
+    const Node *getNext() const;
+
+    const Node *find(std::string_view key) const;
+    const Node *at(size_t index) const;
+private:
+    friend class DocumentBuilder;
+    friend class Document;
+
+    Type type = Type::Null;
+    std::string_view key;
+    std::string_view value;
+    Node *firstChild = nullptr;
+    Node *lastChild = nullptr;
+    Node *next = nullptr;
+    size_t childCount = 0;
+};
+
+// Document tree allocated from an arena: destroying or clearing the
+// document releases all nodes and strings at once.
+class Document {
+public:
+    Document();
+    Document(const Document&) = delete;
+    Document(Document&& other) noexcept;
+
+    Document& operator=(const Document&) = delete;
+    Document& operator=(Document&& other) noexcept;
+
+    const Node *getRoot() const;
+
+    // Looks up a '/' separated path of map keys, e.g. "invoice/bill-to"
+    const Node *find(std::string_view path) const;
+
+    void clear();
+
+    Arena& getArena();
+private:
+    friend class DocumentBuilder;
+
+    Arena arena;
+    Node *root = nullptr;
+};
+
+}
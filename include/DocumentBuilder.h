@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "AbstractEventViewObserver.h"
+#include "AbstractScalarChunkObserver.h"
+#include "Document.h"
+
+namespace YAML {
+
+// Builds a Document from parser events, nesting items by their indentation.
+// Block scalars are joined from their chunks and always copied.
+class DocumentBuilder : public AbstractEventViewObserver, public AbstractScalarChunkObserver {
+public:
+    enum class Strings {
+        // Keys and scalars are copied into the document arena
+        Copy,
+        // Keys and scalars reference the parsed buffer, which must outlive
+        // the document
+        Reference,
+    };
+public:
+    DocumentBuilder(Document& document, Strings strings = Strings::Copy);
+
+    void newMapItem(std::string_view name, int spaces) override;
+    void newScalar(std::string_view scalar) override;
+    void newSequenceItem(int spaces) override;
+    void newScalarChunk(std::string_view chunk, bool last) override;
+
+    // Starts building into another document; the level stack keeps its
+    // capacity
+    void reset(Document& document);
+private:
+    struct Level {
+        Node *node;
+        int spaces;
+    };
+private:
+    Node *openContainer(Node::Type type, int spaces);
+    Node *appendItem(Node *container, std::string_view key);
+    void setScalar(std::string_view value);
+    std::string_view store(std::string_view value);
+private:
+    Document *document = nullptr;
+    Strings strings;
+    std::vector<Level> levels;
+    Node *current = nullptr;
+    std::string blockScalar;
+};
+
+}
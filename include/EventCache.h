@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "AbstractEventBatchObserver.h"
+#include "AbstractEventViewObserver.h"
+#include "MappedFile.h"
+
+namespace YAML {
+
+// Layout of an event cache file: the header, eventCount EventRecords and
+// textSize bytes of text the records point into by offset. All fields are
+// in host byte order; files from a host with another order are rejected.
+struct EventCacheHeader {
+    static constexpr char Magic[4] = {'Y', 'E', 'V', 'C'};
+    static constexpr uint16_t CurrentVersion = 1;
+    static constexpr uint16_t ByteOrderMark = 0x0102;
+
+    char magic[4];
+    uint16_t version;
+    uint16_t byteOrder;
+    uint32_t recordSize;
+    uint32_t flags;
+    // Hash of the YAML source the events were parsed from
+    uint64_t contentHash;
+    uint64_t eventCount;
+    uint64_t textSize;
+};
+
+// Collects parse events and saves them as an event cache file.
+class EventCacheWriter : public AbstractEventViewObserver {
+public:
+    void newMapItem(std::string_view name, int spaces) override;
+    void newScalar(std::string_view scalar) override;
+    void newSequenceItem(int spaces) override;
+
+    bool save(const std::string& path, uint64_t contentHash) const;
+    void clear();
+
+    // Parses data and saves its events to path; nothing is written when
+    // data does not parse
+    static bool write(const char *data, size_t length, const std::string& path);
+private:
+    void add(EventRecord::Kind kind, std::string_view text, int spaces);
+private:
+    std::vector<EventRecord> records;
+    std::string text;
+};
+
+// A mapped event cache file. The events are replayed straight from the
+// mapping, without parsing and without allocating.
+class EventCache {
+public:
+    EventCache() = default;
+    EventCache(const std::string& path);
+
+    // Fails unless the whole file is well formed
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const;
+
+    // True when the cache was written for the YAML source in data
+    bool matches(const char *data, size_t length) const;
+
+    uint64_t getContentHash() const;
+    size_t getEventCount() const;
+
+    // Strings passed to the observers point into the mapping and stay valid
+    // while the cache is open
+    void replay(AbstractEventViewObserver *eventObserver) const;
+    void replay(AbstractEventBatchObserver *eventObserver) const;
+
+    static uint64_t hash(const char *data, size_t length);
+private:
+    bool validate() const;
+private:
+    MappedFile file;
+    const EventCacheHeader *header = nullptr;
+    const EventRecord *records = nullptr;
+    const char *text = nullptr;
+};
+
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <string>
+
+#include "AbstractEventObserver.h"
+#include "AbstractEventViewObserver.h"
+
+namespace YAML {
+
+class EventObserverAdapter : public AbstractEventViewObserver {
+public:
+    EventObserverAdapter(AbstractEventObserver *eventObserver);
+
+    void newMapItem(std::string_view name, int spaces) override;
+    void newScalar(std::string_view scalar) override;
+    void newSequenceItem(int spaces) override;
+private:
+    AbstractEventObserver *eventObserver = nullptr;
+    std::string buffer;
+};
+
+}
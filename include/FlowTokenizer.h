@@ -0,0 +1,190 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace YAML {
+
+// Splits the text of flow collections ([a, b], {k: v}) into tokens. Bytes
+// are classified through one table, so a scalar is scanned in a single loop
+// instead of one parse state step per character. Quoted scalars keep their
+// quotes, like every other scalar of the parser.
+class FlowTokenizer {
+public:
+    enum class Token {
+        End,
+        SequenceBegin,
+        SequenceEnd,
+        MapBegin,
+        MapEnd,
+        Comma,
+        Colon,
+        Scalar,
+        Error,
+    };
+public:
+    FlowTokenizer(const char *begin, const char *end)
+        : begin(begin),
+          current(begin),
+          last(end)
+    {
+    }
+
+    // Skips spaces and a comment; End at the end of the text
+    Token next() {
+        bool afterQuoted = this->afterQuoted;
+        this->afterQuoted = false;
+
+        while (this->current != this->last && classify(*this->current) == Class::Space) {
+            ++this->current;
+        }
+
+        if (this->current == this->last) {
+            return Token::End;
+        }
+
+        const char *position = this->current;
+        switch (classify(*position)) {
+            case Class::Indicator:
+                ++this->current;
+                switch (*position) {
+                    case '[':
+                        return Token::SequenceBegin;
+                    case ']':
+                        return Token::SequenceEnd;
+                    case '{':
+                        return Token::MapBegin;
+                    case '}':
+                        return Token::MapEnd;
+                    default:
+                        return Token::Comma;
+                }
+            case Class::Colon:
+                // A value indicator is followed by a space or an indicator,
+                // except right after a quoted key ("a":1)
+                if (afterQuoted || position + 1 == this->last || classify(position[1]) == Class::Space ||
+                        classify(position[1]) == Class::Indicator) {
+                    ++this->current;
+                    return Token::Colon;
+                }
+                return scanPlain();
+            case Class::Hash:
+                if (position == this->begin || classify(position[-1]) == Class::Space) {
+                    this->current = this->last;
+                    return Token::End;
+                }
+                return scanPlain();
+            case Class::Quote:
+                return scanQuoted();
+            default:
+                return scanPlain();
+        }
+    }
+
+    std::string_view getScalar() const {
+        return this->scalar;
+    }
+
+    const char *position() const {
+        return this->current;
+    }
+private:
+    enum class Class : uint8_t {
+        Plain,
+        Space,
+        Indicator,
+        Quote,
+        Colon,
+        Hash,
+    };
+
+    static constexpr std::array<Class, 256> makeClasses() {
+        std::array<Class, 256> classes = {};
+        for (unsigned char symbol : {' ', '\t', '\r', '\n'}) {
+            classes[symbol] = Class::Space;
+        }
+
+        for (unsigned char symbol : {',', '[', ']', '{', '}'}) {
+            classes[symbol] = Class::Indicator;
+        }
+
+        classes[static_cast<unsigned char>('"')] = Class::Quote;
+        classes[static_cast<unsigned char>('\'')] = Class::Quote;
+        classes[static_cast<unsigned char>(':')] = Class::Colon;
+        classes[static_cast<unsigned char>('#')] = Class::Hash;
+        return classes;
+    }
+
+    static Class classify(char symbol) {
+        static constexpr std::array<Class, 256> classes = makeClasses();
+        return classes[static_cast<unsigned char>(symbol)];
+    }
+
+    // Up to an indicator, ": ", " #" or the end; trailing spaces are not
+    // part of the scalar
+    Token scanPlain() {
+        const char *begin = this->current;
+        const char *end = begin;
+        const char *position = begin;
+        while (position != this->last) {
+            Class symbolClass = classify(*position);
+            if (symbolClass == Class::Indicator) {
+                break;
+            }
+
+            if (symbolClass == Class::Space) {
+                ++position;
+                continue;
+            }
+
+            if (symbolClass == Class::Colon && (position + 1 == this->last ||
+                        classify(position[1]) == Class::Space || classify(position[1]) == Class::Indicator)) {
+                break;
+            }
+
+            if (symbolClass == Class::Hash && classify(position[-1]) == Class::Space) {
+                break;
+            }
+
+            end = ++position;
+        }
+
+        this->scalar = std::string_view(begin, end - begin);
+        this->current = end;
+        return Token::Scalar;
+    }
+
+    Token scanQuoted() {
+        const char *begin = this->current;
+        char quote = *begin;
+        const char *position = begin + 1;
+        while (position != this->last) {
+            if (*position == quote) {
+                // '' is an escaped quote in single quoted scalars
+                if (quote == '\'' && position + 1 != this->last && position[1] == '\'') {
+                    position += 2;
+                    continue;
+                }
+
+                this->scalar = std::string_view(begin, position + 1 - begin);
+                this->current = position + 1;
+                this->afterQuoted = true;
+                return Token::Scalar;
+            }
+
+            position += quote == '"' && *position == '\\' && position + 1 != this->last ? 2 : 1;
+        }
+
+        this->current = this->last;
+        return Token::Error;
+    }
+private:
+    const char *begin = nullptr;
+    const char *current = nullptr;
+    const char *last = nullptr;
+    std::string_view scalar;
+    bool afterQuoted = false;
+};
+
+}
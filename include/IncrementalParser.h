@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "AbstractEventDiffObserver.h"
+#include "AbstractEventViewObserver.h"
+#include "LineParser.h"
+
+namespace YAML {
+
+// Keeps the events of a parsed buffer per line so that after an edit only
+// the lines around the changed bytes are parsed again. The events of a line
+// depend only on its text and on the parse state it starts in, so parsing
+// restarts at the closest line that begins idle and stops at the first
+// line after the edit that begins idle in both versions. The buffer is not
+// retained between calls.
+class IncrementalParser {
+public:
+    IncrementalParser();
+
+    bool parse(const char *data, size_t length);
+
+    // data is the whole edited buffer, where inserted bytes at offset
+    // replaced removed bytes of the previous one. The event changes are
+    // reported to diffObserver when it is set.
+    bool update(const char *data, size_t length, size_t offset, size_t removed, size_t inserted,
+            AbstractEventDiffObserver *diffObserver = nullptr);
+
+    const std::vector<ParsedEvent>& getEvents() const;
+    size_t getLineCount() const;
+
+    // Lines parsed by the last parse or update
+    size_t getParsedLines() const;
+private:
+    struct Line {
+        size_t offset;
+        size_t length;
+        // Index of the first event of the line
+        size_t firstEvent;
+        // No parse state is carried into the line from the previous one
+        bool idle;
+    };
+
+    class EventRecorder : public AbstractEventViewObserver {
+    public:
+        void setEvents(std::vector<ParsedEvent> *events);
+
+        void newMapItem(std::string_view name, int spaces) override;
+        void newScalar(std::string_view scalar) override;
+        void newSequenceItem(int spaces) override;
+    private:
+        std::vector<ParsedEvent> *events = nullptr;
+    };
+private:
+    // Parses the lines of [begin, end) into lines and events; a last empty
+    // line is kept only when more data follows end
+    bool parseLines(const char *data, size_t length, size_t begin, size_t end,
+            std::vector<Line>& lines, std::vector<ParsedEvent>& events);
+    bool parseLine(const char *data, size_t offset, size_t length,
+            std::vector<Line>& lines, std::vector<ParsedEvent>& events);
+    // Events delivered at the end of the input belong to the last line
+    bool finish(std::vector<ParsedEvent>& events);
+
+    // Index of the line holding the byte at offset, including its line
+    // break; the line count for the end of a buffer ending with a break
+    size_t findLine(size_t offset) const;
+    bool isIdleBefore(size_t line) const;
+
+    bool reparse(const char *data, size_t length, AbstractEventDiffObserver *diffObserver);
+
+    static void diff(const ParsedEvent *before, size_t beforeCount, const ParsedEvent *after, size_t afterCount,
+            size_t index, AbstractEventDiffObserver *diffObserver);
+private:
+    EventRecorder recorder;
+    LineParser lineParser;
+    std::vector<Line> lines;
+    std::vector<ParsedEvent> events;
+    size_t length = 0;
+    size_t parsedLines = 0;
+    // Parse state after the last line
+    bool endIdle = true;
+    bool valid = false;
+};
+
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "AbstractEventViewObserver.h"
+#include "AbstractKeyEventObserver.h"
+#include "KeyTable.h"
+
+namespace YAML {
+
+// Interns map keys in a KeyTable, which may be shared between parsers, and
+// forwards events to an AbstractKeyEventObserver. When the table is full the
+// item is still forwarded, with a Key of id KeyTable::NoId whose name points
+// into the parsed data and is only valid during the call.
+class KeyInterningAdapter : public AbstractEventViewObserver {
+public:
+    KeyInterningAdapter(KeyTable& keys, AbstractKeyEventObserver *eventObserver);
+
+    void newMapItem(std::string_view name, int spaces) override;
+    void newScalar(std::string_view scalar) override;
+    void newSequenceItem(int spaces) override;
+private:
+    KeyTable& keys;
+    AbstractKeyEventObserver *eventObserver = nullptr;
+};
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include "Arena.h"
+
+namespace YAML {
+
+// Interning table for map keys. Every distinct key gets one Key with a
+// stable name, a precomputed hash and a dense id, so consumers compare ids
+// instead of strings. Lookups of known keys never lock and may run
+// concurrently with inserts; only inserting a new key takes the mutex.
+class KeyTable {
+public:
+    struct Key {
+        std::string_view name;
+        uint64_t hash;
+        uint32_t id;
+    };
+
+    // Id of a Key made up for a name the table could not hold
+    static constexpr uint32_t NoId = UINT32_MAX;
+public:
+    // Holds at most maxKeys keys, clamped to MaxKeys
+    explicit KeyTable(size_t maxKeys = MaxKeys);
+    KeyTable(const KeyTable&) = delete;
+    ~KeyTable();
+
+    KeyTable& operator=(const KeyTable&) = delete;
+
+    // Returns the Key of name, adding it when missing, or nullptr when the
+    // table is full
+    const Key *intern(std::string_view name);
+
+    // Returns the Key of name, or nullptr when it was never interned
+    const Key *find(std::string_view name) const;
+
+    // Returns the Key with id, or nullptr
+    const Key *get(uint32_t id) const;
+
+    size_t size() const;
+
+    // FNV-1a
+    static uint64_t hash(std::string_view name);
+private:
+    struct Slots {
+        Slots(size_t capacity);
+
+        size_t mask;
+        std::unique_ptr<std::atomic<const Key *>[]> keys;
+    };
+
+    // Keys by id are kept in segments that double in size, so a segment
+    // never moves once readers can see it
+    static constexpr size_t FirstSegmentSize = 64;
+    static constexpr size_t SegmentCount = 24;
+public:
+    static constexpr size_t MaxKeys = FirstSegmentSize * ((size_t(1) << SegmentCount) - 1);
+private:
+    const Key *find(const Slots *slots, std::string_view name, uint64_t hash) const;
+    void insert(Slots *slots, const Key *key);
+    void grow();
+    static void locate(uint32_t id, size_t& segment, size_t& offset);
+private:
+    std::atomic<Slots *> slots;
+    std::atomic<uint32_t> count;
+    std::atomic<const Key **> segments[SegmentCount];
+    const size_t maxKeys;
+
+    // Only touched with mutex held
+    std::mutex mutex;
+    Arena arena;
+    std::vector<std::unique_ptr<Slots>> tables;
+};
+
+}
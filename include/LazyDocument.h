@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "DocumentBuilder.h"
+
+namespace YAML {
+
+// Structural index over a buffer that answers point lookups without a
+// full parse: one pass records line offsets, indentation and key hashes,
+// and only the lines a query touches are parsed. The buffer must outlive
+// the LazyDocument.
+class LazyDocument {
+public:
+    LazyDocument() = default;
+    LazyDocument(const char *data, size_t length);
+
+    void load(const char *data, size_t length);
+
+    // Scalar value of the map item at a '/' separated path of keys. Block
+    // scalars are joined into a buffer of the LazyDocument that is valid
+    // until the next call, so concurrent calls need a document each.
+    bool getValue(std::string_view path, std::string_view& value) const;
+
+    // Parses the block below the map item at path (the whole buffer for an
+    // empty path), or its inline flow collection, into document
+    bool materialize(std::string_view path, Document& document,
+            DocumentBuilder::Strings strings = DocumentBuilder::Strings::Copy) const;
+
+    size_t getLineCount() const;
+private:
+    struct Line {
+        size_t offset;
+        size_t length;
+        // Index of the first line after the block this line opens
+        size_t next;
+        uint64_t keyHash;
+        uint32_t keyOffset;
+        uint32_t keyLength;
+        // Start of an inline flow collection value
+        uint32_t valueOffset;
+        int spaces;
+        bool hasKey;
+        bool blank;
+        bool flowValue;
+        // Inside a block scalar or flow collection opened on a line above
+        bool continuation;
+    };
+
+    // Value of a line that goes on over the following lines
+    struct Continuation {
+        enum class Kind {
+            None,
+            BlockScalar,
+            FlowCollection,
+        };
+
+        Kind kind = Kind::None;
+        // Block scalar lines are indented deeper than this
+        int spaces = 0;
+        // Flow collections still open
+        int depth = 0;
+    };
+
+    static const size_t NotFound = static_cast<size_t>(-1);
+private:
+    void indexLine(Line& line, Continuation& continuation) const;
+    bool continueValue(Line& line, Continuation& continuation) const;
+    size_t findLine(std::string_view path) const;
+    size_t findValueEnd(size_t index) const;
+    std::string_view getKey(const Line& line) const;
+private:
+    const char *data = nullptr;
+    size_t length = 0;
+    std::vector<Line> lines;
+    mutable std::string blockScalar;
+};
+
+}
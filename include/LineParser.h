@@ -1,24 +1,44 @@
 #pragma once
 
+#include <cstddef>
 #include <istream>
 #include <memory>
+#include <string>
 
 namespace YAML {
 
 class AbstractEventObserver;
-class AbstractParseState;
+class AbstractEventViewObserver;
+class NoStatistics;
+template <typename Observer, typename Statistics>
+class ParseStateMachine;
+class StructuralIndex;
 
 class LineParser {
 public:
     LineParser();
     LineParser(AbstractEventObserver *eventObserver);
+    LineParser(AbstractEventViewObserver *eventObserver);
 
     bool parse(std::istream& input);
+    bool parse(const char *data, size_t length);
+    bool parse(const char *data, size_t length, const StructuralIndex& index);
+
+    // True when no parse state is carried over into the next line
+    bool isIdle() const;
+
+    // Ends the input; delivers a block scalar still waiting for the line
+    // after it and fails when a flow collection is still open
+    bool finish();
+
+    // Returns to the initial state, keeping all buffer capacity
+    void reset();
 private:
-    void initStateMachine(AbstractEventObserver *eventObserver = nullptr);
-    int skipSpaces(std::istream& input);
+    void initStateMachine(AbstractEventViewObserver *eventObserver = nullptr);
 private:
-    std::shared_ptr<AbstractParseState> stateMachine;
+    std::string buffer;
+    std::shared_ptr<AbstractEventViewObserver> observerAdapter;
+    std::shared_ptr<ParseStateMachine<AbstractEventViewObserver, NoStatistics>> stateMachine;
 };
 
 }
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace YAML {
+
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const std::string& path);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    ~MappedFile();
+
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const;
+    const char *getData() const;
+    size_t getSize() const;
+private:
+    void swap(MappedFile& other) noexcept;
+private:
+    const char *data = nullptr;
+    size_t size = 0;
+    bool opened = false;
+#ifdef _WIN32
+    void *file = nullptr;
+    void *mapping = nullptr;
+#endif
+};
+
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace YAML {
+
+class AbstractEventObserver;
+class AbstractEventViewObserver;
+
+// Splits a buffer at line boundaries and parses the pieces on several
+// threads. Events are recorded per chunk and replayed to the observer in
+// document order, so the observer sees exactly what Parser would deliver.
+class ParallelParser {
+public:
+    static constexpr size_t DefaultChunkSize = 4 * 1024 * 1024;
+public:
+    ParallelParser(AbstractEventObserver *eventObserver, unsigned threads = 0,
+            size_t chunkSize = DefaultChunkSize);
+    ParallelParser(AbstractEventViewObserver *eventObserver, unsigned threads = 0,
+            size_t chunkSize = DefaultChunkSize);
+
+    bool parse(const char *data, size_t length);
+    bool parseFile(const std::string& path);
+private:
+    std::shared_ptr<AbstractEventViewObserver> observerAdapter;
+    AbstractEventViewObserver *eventObserver = nullptr;
+    unsigned threads = 1;
+    size_t chunkSize = DefaultChunkSize;
+};
+
+}
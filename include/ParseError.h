@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+
+#include "AbstractParseState.h"
+
+namespace YAML {
+
+// Location of a parse failure: 1-based line and column of the character
+// the parser stopped at, its byte offset from the start of the input, and
+// the state that rejected it.
+struct ParseError {
+    size_t line = 0;
+    size_t column = 0;
+    size_t offset = 0;
+    AbstractParseState::State state = AbstractParseState::State::Init;
+};
+
+}
@@ -0,0 +1,844 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "AbstractParseState.h"
+#include "AbstractScalarChunkObserver.h"
+#include "FlowTokenizer.h"
+#include "ParseStatistics.h"
+#include "StructuralIndex.h"
+
+namespace YAML {
+
+// Observer for parsers that only check syntax: every event is compiled out.
+struct NullObserver {
+};
+
+class InputBuffer {
+public:
+    InputBuffer(const char *data, size_t length, const StructuralIndex *index = nullptr)
+        : current(data),
+          last(data + length),
+          index(index != nullptr && index->contains(data, data + length) ? index : nullptr)
+    {
+    }
+
+    const char *position() const {
+        return this->current;
+    }
+
+    const char *end() const {
+        return this->last;
+    }
+
+    void seek(const char *position) {
+        this->current = position;
+    }
+
+    bool eof() const {
+        return this->endOfInput;
+    }
+
+    void setEof() {
+        this->current = this->last;
+        this->endOfInput = true;
+    }
+
+    int peek() {
+        if (this->current != this->last) {
+            return static_cast<unsigned char>(*this->current);
+        }
+
+        this->endOfInput = true;
+        return EOF;
+    }
+
+    bool get(char& symbol) {
+        if (this->current != this->last) {
+            symbol = *this->current++;
+            return true;
+        }
+
+        this->endOfInput = true;
+        return false;
+    }
+
+    void ignore() {
+        char symbol = 0;
+        get(symbol);
+    }
+
+    int skipSpaces() {
+        const char *start = this->current;
+        while (this->current != this->last && isSpace(*this->current)) {
+            ++this->current;
+        }
+
+        if (this->current == this->last) {
+            this->endOfInput = true;
+        }
+
+        return static_cast<int>(this->current - start);
+    }
+
+    // First character in [position, limit) of one of the StructuralIndex
+    // classes in mask, or limit.
+    const char *find(const char *position, const char *limit, unsigned mask) const {
+        if (this->index != nullptr) {
+            return this->index->find(position, limit, mask);
+        }
+
+        while (position != limit && !matches(*position, mask)) {
+            ++position;
+        }
+
+        return position;
+    }
+
+    static bool isSpace(char symbol) {
+        return std::isspace(static_cast<unsigned char>(symbol)) != 0;
+    }
+private:
+    static bool matches(char symbol, unsigned mask) {
+        return ((mask & StructuralIndex::Whitespace) && isSpace(symbol)) ||
+            ((mask & StructuralIndex::Colon) && symbol == ':') ||
+            ((mask & StructuralIndex::CommentEnd) && (symbol == '#' || symbol == '\r')) ||
+            ((mask & StructuralIndex::Newline) && symbol == '\n');
+    }
+private:
+    const char *current = nullptr;
+    const char *last = nullptr;
+    const StructuralIndex *index = nullptr;
+    bool endOfInput = false;
+};
+
+// The parser engine; Observer callbacks are called directly so they can be
+// inlined for a concrete observer type.
+template <typename Observer, typename Statistics = NoStatistics>
+class ParseStateMachine : public AbstractParseState {
+public:
+    ParseStateMachine(Observer *eventObserver = nullptr)
+        : eventObserver(eventObserver),
+          chunkObserver(findChunkObserver(eventObserver))
+    {
+    }
+
+    bool parse(InputBuffer& input) {
+        bool result = false;
+        do {
+            result = step(input);
+        } while (result && !input.eof());
+
+        return result;
+    }
+
+    bool isIdle() const {
+        return this->state == State::Init;
+    }
+
+    // Called at the end of the input: a block scalar is only known to be
+    // complete at the first line outside it. Fails when a flow collection
+    // is still open.
+    bool finish() {
+        if (this->state == State::BlockScalar) {
+            endBlockScalar();
+        } else if (this->state == State::FlowCollection) {
+            this->errorPosition = nullptr;
+            this->errorState = this->state;
+            return false;
+        }
+
+        return true;
+    }
+
+    Statistics& getStatistics() {
+        return this->statistics;
+    }
+
+    const Statistics& getStatistics() const {
+        return this->statistics;
+    }
+
+    // Where and in which state the last failure was detected; only written
+    // on the error path
+    const char *getErrorPosition() const {
+        return this->errorPosition;
+    }
+
+    State getErrorState() const {
+        return this->errorState;
+    }
+
+    void clearError() {
+        this->errorPosition = nullptr;
+    }
+
+    // Back to the initial state; scalarStorage keeps its capacity
+    void reset() {
+        init();
+        this->scalarState = State::Scalar;
+        this->scalarStorage.clear();
+        this->block = Block();
+        this->flowLevels.clear();
+        clearError();
+    }
+private:
+    bool step(InputBuffer& input) {
+        this->statistics.addStep(this->state);
+        switch (this->state) {
+            case State::Init:
+                return parseInit(input);
+            case State::Spaces:
+                return parseSpaces(input);
+            case State::Scalar:
+                return parseScalar(input);
+            case State::ComplexScalar:
+                return parseComplexScalar(input);
+            case State::SequenceScalar:
+                return parseSequenceScalar(input);
+            case State::Map:
+                return parseMap(input);
+            case State::Comments:
+                return parseComments(input);
+            case State::Sequence:
+                return parseSequence(input);
+            case State::BlockScalar:
+                return parseBlockScalar(input);
+            case State::FlowCollection:
+                return parseFlowCollection(input);
+            case State::Error:
+                if (this->errorPosition == nullptr) {
+                    setError(input.position());
+                }
+                break;
+        }
+
+        return false;
+    }
+
+    bool dispatch(InputBuffer& input) {
+        int symbol = input.peek();
+        if (symbol != EOF) {
+            switch (symbol) {
+                case '-':
+                    this->state = State::Sequence;
+                    break;
+                case '#':
+                    this->state = State::Comments;
+                    break;
+                case ':':
+                    input.ignore();
+                    this->state = State::Map;
+                    break;
+                default:
+                    this->state = this->scalarState;
+                    break;
+            }
+        } else {
+            makeEvents();
+        }
+
+        return true;
+    }
+
+    bool parseInit(InputBuffer& input) {
+        this->spaces = input.skipSpaces();
+        this->scalarState = State::Scalar;
+        if (startFlowCollection(input, this->spaces - 1)) {
+            return true;
+        }
+
+        return dispatch(input);
+    }
+
+    bool parseSpaces(InputBuffer& input) {
+        input.skipSpaces();
+        return dispatch(input);
+    }
+
+    bool parseScalar(InputBuffer& input) {
+        const char *begin = input.position();
+        const char *current = input.find(begin, input.end(),
+                StructuralIndex::Whitespace | StructuralIndex::Colon);
+
+        addScalar(std::string_view(begin, current - begin));
+        if (current == input.end()) {
+            input.setEof();
+            makeEvents();
+        } else {
+            input.seek(current + 1);
+            this->state = *current == ':' ? State::Map : State::Spaces;
+        }
+
+        return true;
+    }
+
+    bool parseComplexScalar(InputBuffer& input) {
+        if (!input.eof()) {
+            input.skipSpaces();
+            if (startFlowCollection(input, this->spaces)) {
+                return true;
+            }
+
+            const char *begin = input.position();
+            const char *current = input.find(begin, input.end(), StructuralIndex::CommentEnd);
+
+            input.setEof();
+
+            std::string_view scalar = rtrim(std::string_view(begin, current - begin));
+            if (startBlockScalar(scalar)) {
+                return true;
+            }
+
+            if (!scalar.empty()) {
+                addScalar(scalar);
+                makeEvents();
+            }
+        } else {
+            makeEvents();
+        }
+
+        return true;
+    }
+
+    bool parseSequenceScalar(InputBuffer& input) {
+        std::string_view scalar;
+        if (!input.eof()) {
+            int spaces = input.skipSpaces();
+            if (startFlowCollection(input, this->spaces)) {
+                return true;
+            }
+
+            const char *begin = input.position();
+            const char *current = input.find(begin, input.end(), StructuralIndex::Colon);
+
+            scalar = std::string_view(begin, current - begin);
+            if (current == input.end()) {
+                input.setEof();
+            } else if (containsSpaces(input, rtrim(scalar))) {
+                setError(begin);
+                input.seek(current + 1);
+                this->state = State::Error;
+            } else {
+                input.seek(current + 1);
+                addScalar(scalar);
+                this->spaces += spaces + 2;
+                this->state = State::Map;
+            }
+        }
+
+        if (input.eof() && !startBlockScalar(rtrim(scalar))) {
+            addScalar(scalar);
+            makeEvents();
+        }
+
+        return true;
+    }
+
+    bool parseMap(InputBuffer& input) {
+        char symbol = 0;
+        if (!input.get(symbol) || InputBuffer::isSpace(symbol)) {
+            generateMapEvent();
+
+            this->scalarState = State::ComplexScalar;
+            this->state = State::Spaces;
+            return true;
+        }
+
+        setError(input.position() - 1);
+        retainScalar();
+        return false;
+    }
+
+    bool parseComments(InputBuffer& input) {
+        char symbol = 0;
+        if (input.get(symbol) && symbol == '#') {
+            makeEvents();
+
+            input.setEof();
+            return true;
+        }
+
+        setError(input.position());
+        this->state = State::Error;
+        return false;
+    }
+
+    bool parseSequence(InputBuffer& input) {
+        char symbol = 0;
+        if (input.get(symbol) && symbol == '-') {
+            if (input.get(symbol) && !InputBuffer::isSpace(symbol)) {
+                setError(input.position() - 1);
+                this->state = State::Error;
+            } else {
+                generateSequenceEvent();
+                this->state = State::SequenceScalar;
+                return true;
+            }
+        } else {
+            setError(input.position());
+            this->state = State::Error;
+        }
+
+        return false;
+    }
+
+    // Starts a block scalar when value is a block header like "|", ">-" or
+    // "|2", optionally followed by a comment
+    bool startBlockScalar(std::string_view value) {
+        if (value.empty() || (value.front() != '|' && value.front() != '>')) {
+            return false;
+        }
+
+        Block block;
+        block.folded = value.front() == '>';
+        block.parentSpaces = this->spaces;
+
+        size_t position = 1;
+        for (; position < value.size() && position < 3; ++position) {
+            char symbol = value[position];
+            if ((symbol == '-' || symbol == '+') && block.chomping == Chomping::Clip) {
+                block.chomping = symbol == '-' ? Chomping::Strip : Chomping::Keep;
+            } else if (symbol >= '1' && symbol <= '9' && block.indent < 0) {
+                block.indent = this->spaces + (symbol - '0');
+            } else {
+                break;
+            }
+        }
+
+        std::string_view rest = value.substr(position);
+        if (!rest.empty() && !(InputBuffer::isSpace(rest.front()) && rtrim(rest.substr(0, rest.find('#'))).empty())) {
+            return false;
+        }
+
+        this->block = block;
+        this->scalar = std::string_view();
+        this->scalarStorage.clear();
+        this->state = State::BlockScalar;
+        return true;
+    }
+
+    bool parseBlockScalar(InputBuffer& input) {
+        const char *begin = input.position();
+        const char *end = input.end();
+        if (end != begin && end[-1] == '\r') {
+            --end;
+        }
+
+        const char *content = begin;
+        while (content != end && *content == ' ') {
+            ++content;
+        }
+
+        int indent = static_cast<int>(content - begin);
+        if (content == end && (this->block.indent < 0 || indent <= this->block.indent)) {
+            ++this->block.breaks;
+            input.setEof();
+            return true;
+        }
+
+        if (this->block.indent < 0 && indent > this->block.parentSpaces) {
+            this->block.indent = indent;
+        }
+
+        if (indent < this->block.indent || this->block.indent < 0) {
+            // The line is not part of the scalar and is parsed from the start
+            endBlockScalar();
+            return true;
+        }
+
+        addBlockLine(std::string_view(begin + this->block.indent, end - (begin + this->block.indent)));
+        input.setEof();
+        return true;
+    }
+
+    void addBlockLine(std::string_view line) {
+        bool moreIndented = !line.empty() && InputBuffer::isSpace(line.front());
+        if (this->block.hasContent && this->block.folded && !moreIndented && !this->block.moreIndented) {
+            // Folding: a single line break becomes a space, otherwise one
+            // break fewer is kept
+            if (this->block.breaks == 1) {
+                addBlockText(" ");
+            } else {
+                addBlockBreaks(this->block.breaks - 1);
+            }
+        } else {
+            addBlockBreaks(this->block.breaks);
+        }
+
+        addBlockText(line);
+        this->block.hasContent = true;
+        this->block.moreIndented = moreIndented;
+        this->block.breaks = 1;
+    }
+
+    void endBlockScalar() {
+        if (this->block.chomping == Chomping::Keep) {
+            addBlockBreaks(this->block.breaks);
+        } else if (this->block.chomping == Chomping::Clip && this->block.hasContent) {
+            addBlockBreaks(1);
+        }
+
+        if (this->block.size != 0) {
+            this->statistics.addScalar(this->block.size);
+            if (this->chunkObserver != nullptr) {
+                this->chunkObserver->newScalarChunk(std::string_view(), true);
+            } else if constexpr (HasEvents) {
+                if (this->eventObserver != nullptr) {
+                    this->eventObserver->newScalar(this->scalarStorage);
+                }
+            }
+        }
+
+        this->scalarStorage.clear();
+        init();
+    }
+
+    void addBlockBreaks(size_t count) {
+        const std::string_view breaks("\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n");
+        while (count != 0) {
+            size_t size = std::min(count, breaks.size());
+            addBlockText(breaks.substr(0, size));
+            count -= size;
+        }
+    }
+
+    void addBlockText(std::string_view text) {
+        this->block.size += text.size();
+        if (this->chunkObserver != nullptr) {
+            if (!text.empty()) {
+                this->chunkObserver->newScalarChunk(text, false);
+            }
+        } else if constexpr (HasEvents) {
+            this->scalarStorage.append(text);
+        }
+    }
+
+    // Items of a flow collection are indented one space deeper per level
+    // than baseSpaces
+    bool startFlowCollection(InputBuffer& input, int baseSpaces) {
+        int symbol = input.peek();
+        if (symbol != '[' && symbol != '{') {
+            return false;
+        }
+
+        this->flowBaseSpaces = baseSpaces;
+        this->flowLevels.clear();
+        this->state = State::FlowCollection;
+        return true;
+    }
+
+    bool parseFlowCollection(InputBuffer& input) {
+        FlowTokenizer tokenizer(input.position(), input.end());
+        for (;;) {
+            FlowTokenizer::Token token = tokenizer.next();
+            if (token == FlowTokenizer::Token::End) {
+                // An open collection continues on the next line
+                input.setEof();
+                return true;
+            }
+
+            if (!addFlowToken(token, tokenizer)) {
+                break;
+            }
+
+            if (this->flowLevels.empty()) {
+                // Only a comment may follow the collection
+                if (tokenizer.next() != FlowTokenizer::Token::End) {
+                    break;
+                }
+
+                input.setEof();
+                init();
+                return true;
+            }
+        }
+
+        setError(tokenizer.position());
+        this->state = State::Error;
+        return false;
+    }
+
+    bool addFlowToken(FlowTokenizer::Token token, FlowTokenizer& tokenizer) {
+        using Token = FlowTokenizer::Token;
+        using Kind = typename FlowLevel::Kind;
+        using Phase = typename FlowLevel::Phase;
+
+        int spaces = this->flowBaseSpaces + static_cast<int>(this->flowLevels.size());
+        if (token == Token::SequenceBegin || token == Token::MapBegin) {
+            if (!this->flowLevels.empty() && !startFlowValue(spaces)) {
+                return false;
+            }
+
+            this->flowLevels.push_back(token == Token::MapBegin ?
+                    FlowLevel{Kind::Map, Phase::Key} : FlowLevel{Kind::Sequence, Phase::Value});
+            return true;
+        }
+
+        if (this->flowLevels.empty()) {
+            return false;
+        }
+
+        FlowLevel *level = &this->flowLevels.back();
+        switch (token) {
+            case Token::Scalar:
+                if (level->kind == Kind::Map && level->phase == Phase::Key) {
+                    addFlowMapItem(tokenizer.getScalar(), spaces);
+                    level->phase = Phase::Colon;
+                    return true;
+                }
+
+                if (level->kind == Kind::Sequence && level->phase == Phase::Value) {
+                    // "[key: value]" is a sequence item holding a single pair
+                    std::string_view scalar = tokenizer.getScalar();
+                    FlowTokenizer lookahead = tokenizer;
+                    if (lookahead.next() == Token::Colon) {
+                        tokenizer = lookahead;
+                        addFlowSequenceItem(spaces);
+                        addFlowMapItem(scalar, spaces + 1);
+                        level->phase = Phase::Done;
+                        this->flowLevels.push_back({Kind::Pair, Phase::Value});
+                        return true;
+                    }
+                }
+
+                if (!startFlowValue(spaces)) {
+                    return false;
+                }
+
+                addFlowScalar(tokenizer.getScalar());
+                return true;
+            case Token::Colon:
+                if (level->kind != Kind::Map || level->phase != Phase::Colon) {
+                    return false;
+                }
+
+                level->phase = Phase::Value;
+                return true;
+            case Token::Comma:
+                // Only an entry ends with a comma; "[,]" and "{a: 1,,}" are
+                // errors, a trailing comma is not
+                if ((level->kind == Kind::Sequence && level->phase == Phase::Value) ||
+                        (level->kind == Kind::Map && level->phase == Phase::Key)) {
+                    return false;
+                }
+
+                if (level->kind == Kind::Pair) {
+                    this->flowLevels.pop_back();
+                    level = &this->flowLevels.back();
+                }
+
+                level->phase = level->kind == Kind::Map ? Phase::Key : Phase::Value;
+                return true;
+            case Token::SequenceEnd:
+            case Token::MapEnd:
+                if (level->kind == Kind::Pair && token == Token::SequenceEnd) {
+                    this->flowLevels.pop_back();
+                    level = &this->flowLevels.back();
+                }
+
+                if (level->kind != (token == Token::MapEnd ? Kind::Map : Kind::Sequence)) {
+                    return false;
+                }
+
+                this->flowLevels.pop_back();
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // Starts the next entry of the innermost collection, which must expect
+    // a value
+    bool startFlowValue(int spaces) {
+        auto& level = this->flowLevels.back();
+        if (level.phase != FlowLevel::Phase::Value) {
+            return false;
+        }
+
+        if (level.kind == FlowLevel::Kind::Sequence) {
+            addFlowSequenceItem(spaces);
+        }
+
+        level.phase = FlowLevel::Phase::Done;
+        return true;
+    }
+
+    void addFlowMapItem(std::string_view name, int spaces) {
+        this->statistics.addMapItem(spaces);
+        if constexpr (HasEvents) {
+            if (this->eventObserver != nullptr) {
+                this->eventObserver->newMapItem(name, spaces);
+            }
+        }
+    }
+
+    void addFlowScalar(std::string_view scalar) {
+        this->statistics.addScalar(scalar.size());
+        if constexpr (HasEvents) {
+            if (this->eventObserver != nullptr) {
+                this->eventObserver->newScalar(scalar);
+            }
+        }
+    }
+
+    void addFlowSequenceItem(int spaces) {
+        this->statistics.addSequenceItem(spaces);
+        if constexpr (HasEvents) {
+            if (this->eventObserver != nullptr) {
+                this->eventObserver->newSequenceItem(spaces);
+            }
+        }
+    }
+
+    void setError(const char *position) {
+        this->errorPosition = position;
+        this->errorState = this->state;
+    }
+
+    void addScalar(std::string_view scalar) {
+        this->scalar = rtrim(scalar);
+    }
+
+    // Scalars are views into the line being parsed; keep a copy when one
+    // has to outlive it.
+    void retainScalar() {
+        if (!this->scalar.empty() && this->scalar.data() != this->scalarStorage.data()) {
+            this->scalarStorage.assign(this->scalar);
+            this->scalar = this->scalarStorage;
+        }
+    }
+
+    void generateMapEvent() {
+        if (!this->scalar.empty()) {
+            this->statistics.addMapItem(this->spaces);
+            if constexpr (HasEvents) {
+                if (this->eventObserver != nullptr) {
+                    this->eventObserver->newMapItem(this->scalar, this->spaces);
+                }
+            }
+
+            this->scalar = std::string_view();
+        } else {
+            this->state = State::Error;
+        }
+    }
+
+    void generateSequenceEvent() {
+        this->statistics.addSequenceItem(this->spaces);
+        if constexpr (HasEvents) {
+            if (this->eventObserver != nullptr) {
+                this->eventObserver->newSequenceItem(this->spaces);
+            }
+        }
+    }
+
+    void makeEvents() {
+        if (!this->scalar.empty()) {
+            this->statistics.addScalar(this->scalar.size());
+        }
+
+        if constexpr (HasEvents) {
+            if (!this->scalar.empty() && this->eventObserver != nullptr) {
+                this->eventObserver->newScalar(this->scalar);
+            }
+        }
+
+        init();
+    }
+
+    void init() {
+        this->state = State::Init;
+        this->spaces = 0;
+        this->scalar = std::string_view();
+    }
+
+    static AbstractScalarChunkObserver *findChunkObserver(Observer *eventObserver) {
+        if constexpr (std::is_base_of<AbstractScalarChunkObserver, Observer>::value) {
+            return eventObserver;
+        } else if constexpr (std::is_polymorphic<Observer>::value) {
+            return dynamic_cast<AbstractScalarChunkObserver *>(eventObserver);
+        } else {
+            return nullptr;
+        }
+    }
+
+    static bool containsSpaces(const InputBuffer& input, std::string_view value) {
+        const char *end = value.data() + value.size();
+        return input.find(value.data(), end, StructuralIndex::Whitespace) != end;
+    }
+
+    static std::string_view rtrim(std::string_view value) {
+        while (!value.empty() && InputBuffer::isSpace(value.back())) {
+            value.remove_suffix(1);
+        }
+
+        return value;
+    }
+private:
+    enum class Chomping {
+        Clip,
+        Strip,
+        Keep,
+    };
+
+    // The block scalar being read
+    struct Block {
+        bool folded = false;
+        Chomping chomping = Chomping::Clip;
+        int parentSpaces = 0;
+        // Indentation of the content; negative until the first content line
+        int indent = -1;
+        // Line breaks since the last content line, or blank lines before
+        // the first one
+        size_t breaks = 0;
+        size_t size = 0;
+        bool hasContent = false;
+        bool moreIndented = false;
+    };
+
+    // An open flow collection; Pair is the implicit map of "[key: value]"
+    struct FlowLevel {
+        enum class Kind : uint8_t {
+            Sequence,
+            Map,
+            Pair,
+        };
+
+        // What the collection expects next; Colon follows a map key and
+        // Done an entry
+        enum class Phase : uint8_t {
+            Key,
+            Colon,
+            Value,
+            Done,
+        };
+
+        Kind kind;
+        Phase phase;
+    };
+
+    static constexpr bool HasEvents = !std::is_same<Observer, NullObserver>::value;
+
+    State state = State::Init;
+    State scalarState = State::Scalar;
+    std::string_view scalar;
+    std::string scalarStorage;
+    int spaces = 0;
+    Block block;
+    std::vector<FlowLevel> flowLevels;
+    int flowBaseSpaces = 0;
+    Observer *eventObserver = nullptr;
+    AbstractScalarChunkObserver *chunkObserver = nullptr;
+    Statistics statistics;
+    const char *errorPosition = nullptr;
+    State errorState = State::Init;
+};
+
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "AbstractParseState.h"
+
+namespace YAML {
+
+enum class ParsePhase {
+    // Building the structural index of a window
+    Index,
+    // Running the state machine over lines
+    Lines,
+};
+
+// Statistics policy of BasicParser that collects nothing; every call is
+// empty and compiles away.
+class NoStatistics {
+public:
+    class Timer {
+    public:
+        Timer(NoStatistics&, ParsePhase) {
+        }
+    };
+public:
+    void addLine(size_t) {
+    }
+
+    void addStep(AbstractParseState::State) {
+    }
+
+    void addMapItem(int) {
+    }
+
+    void addScalar(size_t) {
+    }
+
+    void addSequenceItem(int) {
+    }
+};
+
+// Statistics policy that counts what the parser does. Counters accumulate
+// until clear(), across reset() and across documents.
+class ParseStatistics {
+public:
+    static constexpr size_t PhaseCount = static_cast<size_t>(ParsePhase::Lines) + 1;
+
+    class Timer {
+    public:
+        Timer(ParseStatistics& statistics, ParsePhase phase)
+            : statistics(statistics),
+              phase(phase),
+              start(std::chrono::steady_clock::now())
+        {
+        }
+
+        ~Timer() {
+            this->statistics.time[static_cast<size_t>(this->phase)] +=
+                std::chrono::steady_clock::now() - this->start;
+        }
+    private:
+        ParseStatistics& statistics;
+        ParsePhase phase;
+        std::chrono::steady_clock::time_point start;
+    };
+public:
+    void addLine(size_t length) {
+        ++this->lines;
+        this->bytes += length;
+    }
+
+    void addStep(AbstractParseState::State state) {
+        ++this->steps[static_cast<size_t>(state)];
+    }
+
+    void addMapItem(int spaces) {
+        ++this->mapItems;
+        this->maxSpaces = std::max(this->maxSpaces, spaces);
+    }
+
+    void addScalar(size_t length) {
+        ++this->scalars;
+        this->longestScalar = std::max(this->longestScalar, length);
+    }
+
+    void addSequenceItem(int spaces) {
+        ++this->sequenceItems;
+        this->maxSpaces = std::max(this->maxSpaces, spaces);
+    }
+
+    uint64_t getSteps(AbstractParseState::State state) const {
+        return this->steps[static_cast<size_t>(state)];
+    }
+
+    std::chrono::nanoseconds getTime(ParsePhase phase) const {
+        return this->time[static_cast<size_t>(phase)];
+    }
+
+    void clear() {
+        *this = ParseStatistics();
+    }
+public:
+    // Line content, line breaks excluded
+    uint64_t bytes = 0;
+    uint64_t lines = 0;
+    uint64_t mapItems = 0;
+    uint64_t scalars = 0;
+    uint64_t sequenceItems = 0;
+    // Deepest indentation of a map or sequence item, in columns
+    int maxSpaces = 0;
+    size_t longestScalar = 0;
+private:
+    // State machine steps taken in each state
+    std::array<uint64_t, AbstractParseState::StateCount> steps = {};
+    std::array<std::chrono::nanoseconds, PhaseCount> time = {};
+};
+
+}
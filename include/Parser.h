@@ -1,19 +1,51 @@
 #pragma once
 
+#include <cstddef>
 #include <istream>
+#include <memory>
+#include <string>
 
-#include "LineParser.h"
+#include "AbstractEventViewObserver.h"
+#include "BasicParser.h"
 
 namespace YAML {
 
+class AbstractEventObserver;
+
+extern template class BasicParser<AbstractEventViewObserver>;
+
+// Type-erased parser: events are delivered through the virtual observer
+// interfaces.
 class Parser {
 public:
     Parser() = default;
     Parser(AbstractEventObserver *eventObserver);
+    Parser(AbstractEventViewObserver *eventObserver);
 
     bool parse(std::istream& input);
+    bool parse(const char *data, size_t length);
+    bool parseFile(const std::string& path);
+
+    // Incremental parsing: events for each line are emitted as soon as the
+    // line is complete, those of a block scalar with the line after it; at
+    // most one partial line is buffered between calls.
+    bool feed(const char *data, size_t length);
+    bool finish();
+
+    // Feeds the last piece of the input; its unterminated last line is
+    // parsed in place, as with parse()
+    bool finish(const char *data, size_t length);
+
+    bool isIdle() const;
+
+    // Returns to the initial state, keeping all buffer capacity
+    void reset();
+
+    // Where the last failed parse stopped
+    const ParseError& getError() const;
 private:
-    LineParser lineParser;
+    std::shared_ptr<AbstractEventViewObserver> observerAdapter;
+    BasicParser<AbstractEventViewObserver> parser;
 };
 
 }
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace YAML {
+
+// A scalar classified by the YAML 1.2 core schema: null, booleans,
+// decimal/octal (0o)/hexadecimal (0x) integers and floats including .inf
+// and .nan. Anything else stays a string.
+class ScalarValue {
+public:
+    enum class Type {
+        String,
+        Null,
+        Bool,
+        Integer,
+        Float,
+    };
+public:
+    ScalarValue() = default;
+
+    static ScalarValue classify(std::string_view text);
+
+    Type getType() const;
+    std::string_view getText() const;
+
+    bool getBool() const;
+    int64_t getInteger() const;
+    // Integers are converted as well
+    double getFloat() const;
+private:
+    bool classifyNumber();
+private:
+    Type type = Type::Null;
+    std::string_view text;
+    bool boolean = false;
+    int64_t integer = 0;
+    double real = 0.0;
+};
+
+}
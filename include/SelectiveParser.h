@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ParseStateMachine.h"
+
+namespace YAML {
+
+class AbstractEventViewObserver;
+
+// Tracks the key path of each event and forwards only the events of the
+// subtrees below registered paths. Paths are '/' separated map keys;
+// sequence items do not add a component, so "product/sku" matches the sku
+// of every item in the product sequence.
+class PathFilter {
+public:
+    PathFilter(AbstractEventViewObserver *eventObserver);
+
+    void addPath(std::string_view path);
+    void clear();
+
+    void newMapItem(std::string_view name, int spaces);
+    void newScalar(std::string_view scalar);
+    void newSequenceItem(int spaces);
+
+    // Lines indented deeper than this belong to a subtree no registered
+    // path can reach; negative when nothing can be skipped
+    int getSkipSpaces() const;
+private:
+    struct Level {
+        std::string key;
+        int spaces;
+    };
+
+    enum class Match {
+        None,
+        Prefix,
+        Full,
+    };
+private:
+    Match match() const;
+private:
+    AbstractEventViewObserver *eventObserver = nullptr;
+    std::vector<std::vector<std::string>> paths;
+    std::vector<Level> levels;
+    // Indentation of the matched key whose subtree is being forwarded
+    int emitSpaces = -1;
+    int skipSpaces = -1;
+};
+
+// Parser for point lookups: events are delivered only for the registered
+// paths, and lines inside subtrees that cannot match are skipped after
+// finding their end, without running the state machine. Lines that may
+// leave it expecting more, like a bare "key:", are still parsed so the
+// following lines see the state Parser would. Skipped lines are not
+// checked for syntax errors.
+class SelectiveParser {
+public:
+    SelectiveParser(AbstractEventViewObserver *eventObserver);
+
+    void addPath(std::string_view path);
+
+    bool parse(const char *data, size_t length);
+    bool parseFile(const std::string& path);
+
+    // Lines of the last parse that were skipped
+    size_t getSkippedLines() const;
+private:
+    bool parseLine(const char *data, size_t length);
+private:
+    PathFilter filter;
+    ParseStateMachine<PathFilter> stateMachine;
+    size_t skippedLines = 0;
+};
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace YAML {
+
+class StructuralIndex {
+public:
+    enum class Implementation {
+        Scalar,
+        SSE2,
+        AVX2,
+    };
+
+    enum Mask : unsigned {
+        Whitespace = 1u << 0,
+        Colon = 1u << 1,
+        CommentEnd = 1u << 2,
+        Newline = 1u << 3,
+    };
+public:
+    static Implementation getBestImplementation();
+    static bool isSupported(Implementation implementation);
+
+    void build(const char *begin, const char *end);
+    void build(const char *begin, const char *end, Implementation implementation);
+
+    const char *getBegin() const;
+    const char *getEnd() const;
+    bool contains(const char *begin, const char *end) const;
+
+    // Position of the first character in [position, limit) that belongs to
+    // one of the classes in mask, or limit.
+    const char *find(const char *position, const char *limit, unsigned mask) const;
+public:
+    struct Block {
+        uint64_t whitespace;
+        uint64_t colon;
+        uint64_t commentEnd;
+        uint64_t newline;
+    };
+
+    static constexpr size_t BlockSize = 64;
+private:
+    const char *begin = nullptr;
+    const char *end = nullptr;
+    std::vector<Block> blocks;
+};
+
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "AbstractEventViewObserver.h"
+#include "AbstractTypedEventObserver.h"
+
+namespace YAML {
+
+// Classifies each scalar once as it is emitted and forwards events to an
+// AbstractTypedEventObserver
+class TypedScalarAdapter : public AbstractEventViewObserver {
+public:
+    TypedScalarAdapter(AbstractTypedEventObserver *eventObserver);
+
+    void newMapItem(std::string_view name, int spaces) override;
+    void newScalar(std::string_view scalar) override;
+    void newSequenceItem(int spaces) override;
+private:
+    AbstractTypedEventObserver *eventObserver = nullptr;
+};
+
+}
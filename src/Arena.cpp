@@ -0,0 +1,121 @@
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "Arena.h"
+
+namespace {
+
+constexpr size_t HeaderSize = (sizeof(void *) + sizeof(size_t) + alignof(std::max_align_t) - 1) &
+    ~(alignof(std::max_align_t) - 1);
+
+}
+
+YAML::Arena::Arena(size_t blockSize)
+    : blockSize(blockSize > HeaderSize ? blockSize : DefaultBlockSize)
+{
+}
+
+YAML::Arena::Arena(Arena&& other) noexcept
+{
+    swap(other);
+}
+
+YAML::Arena::~Arena()
+{
+    release(this->head);
+}
+
+YAML::Arena&
+YAML::Arena::operator=(Arena&& other) noexcept
+{
+    if (this != &other) {
+        release(this->head);
+        this->head = nullptr;
+        this->current = this->end = nullptr;
+        this->allocatedSize = 0;
+        swap(other);
+    }
+
+    return *this;
+}
+
+void *
+YAML::Arena::allocate(size_t size, size_t alignment)
+{
+    auto position = reinterpret_cast<uintptr_t>(this->current);
+    auto aligned = (position + alignment - 1) & ~(uintptr_t(alignment) - 1);
+    if (this->current == nullptr || aligned + size > reinterpret_cast<uintptr_t>(this->end)) {
+        size_t required = HeaderSize + size + alignment;
+        size_t newBlockSize = required > this->blockSize ? required : this->blockSize;
+
+        auto block = static_cast<Block *>(std::malloc(newBlockSize));
+        if (block == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        block->next = this->head;
+        block->size = newBlockSize;
+        this->head = block;
+        this->current = reinterpret_cast<char *>(block) + HeaderSize;
+        this->end = reinterpret_cast<char *>(block) + newBlockSize;
+
+        position = reinterpret_cast<uintptr_t>(this->current);
+        aligned = (position + alignment - 1) & ~(uintptr_t(alignment) - 1);
+    }
+
+    this->current = reinterpret_cast<char *>(aligned + size);
+    this->allocatedSize += size;
+    return reinterpret_cast<void *>(aligned);
+}
+
+std::string_view
+YAML::Arena::copy(std::string_view value)
+{
+    if (value.empty()) {
+        return std::string_view();
+    }
+
+    auto data = static_cast<char *>(allocate(value.size(), 1));
+    std::memcpy(data, value.data(), value.size());
+    return std::string_view(data, value.size());
+}
+
+void
+YAML::Arena::clear()
+{
+    if (this->head != nullptr) {
+        release(this->head->next);
+        this->head->next = nullptr;
+        this->current = reinterpret_cast<char *>(this->head) + HeaderSize;
+        this->end = reinterpret_cast<char *>(this->head) + this->head->size;
+    }
+
+    this->allocatedSize = 0;
+}
+
+size_t
+YAML::Arena::getAllocatedSize() const
+{
+    return this->allocatedSize;
+}
+
+void
+YAML::Arena::release(Block *block)
+{
+    while (block != nullptr) {
+        Block *next = block->next;
+        std::free(block);
+        block = next;
+    }
+}
+
+void
+YAML::Arena::swap(Arena& other) noexcept
+{
+    std::swap(this->head, other.head);
+    std::swap(this->current, other.current);
+    std::swap(this->end, other.end);
+    std::swap(this->blockSize, other.blockSize);
+    std::swap(this->allocatedSize, other.allocatedSize);
+}
@@ -0,0 +1,258 @@
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "AsyncFileParser.h"
+
+namespace {
+
+// File read at explicit offsets, pread on POSIX
+class BlockFile {
+public:
+    BlockFile(const BlockFile&) = delete;
+    BlockFile& operator=(const BlockFile&) = delete;
+
+#ifdef _WIN32
+    BlockFile(const std::string& path)
+        : file(CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                    OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr))
+    {
+    }
+
+    ~BlockFile() {
+        if (isOpen()) {
+            CloseHandle(this->file);
+        }
+    }
+
+    bool isOpen() const {
+        return this->file != INVALID_HANDLE_VALUE;
+    }
+
+    // Bytes read, 0 at the end of the file, -1 on failure
+    long long read(char *buffer, size_t size, unsigned long long offset) {
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = static_cast<DWORD>(offset);
+        overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+        DWORD count = 0;
+        if (!ReadFile(this->file, buffer, static_cast<DWORD>(std::min<size_t>(size, 1u << 30)),
+                    &count, &overlapped)) {
+            return GetLastError() == ERROR_HANDLE_EOF ? 0 : -1;
+        }
+
+        return count;
+    }
+private:
+    HANDLE file = INVALID_HANDLE_VALUE;
+#else
+    BlockFile(const std::string& path)
+        : file(::open(path.c_str(), O_RDONLY))
+    {
+#ifdef POSIX_FADV_SEQUENTIAL
+        if (isOpen()) {
+            posix_fadvise(this->file, 0, 0, POSIX_FADV_SEQUENTIAL);
+        }
+#endif
+    }
+
+    ~BlockFile() {
+        if (isOpen()) {
+            ::close(this->file);
+        }
+    }
+
+    bool isOpen() const {
+        return this->file >= 0;
+    }
+
+    // Bytes read, 0 at the end of the file, -1 on failure
+    long long read(char *buffer, size_t size, unsigned long long offset) {
+        return pread(this->file, buffer, size, static_cast<off_t>(offset));
+    }
+private:
+    int file = -1;
+#endif
+};
+
+// Ring of blocks passed between the reader thread and the parser
+class BlockQueue {
+public:
+    struct Block {
+        char *data;
+        size_t size;
+    };
+public:
+    BlockQueue(size_t blockSize, size_t blockCount)
+        : storage(new char[blockSize * blockCount]),
+          blockSize(blockSize)
+    {
+        for (size_t i = 0; i < blockCount; ++i) {
+            this->free.push_back(this->storage.get() + i * blockSize);
+        }
+    }
+
+    size_t getBlockSize() const {
+        return this->blockSize;
+    }
+
+    // Reader side: an empty block to fill, or nullptr once the parser stopped
+    char *acquire() {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->changed.wait(lock, [this]() { return !this->free.empty() || this->stopped; });
+        if (this->stopped) {
+            return nullptr;
+        }
+
+        char *data = this->free.front();
+        this->free.pop_front();
+        return data;
+    }
+
+    void push(char *data, size_t size) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->filled.push_back({data, size});
+        this->changed.notify_all();
+    }
+
+    // The reader is done; failed when the file could not be read
+    void close(bool failed) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->closed = true;
+        this->failed = failed;
+        this->changed.notify_all();
+    }
+
+    // Parser side: the next block in file order, false after the last one
+    bool pop(Block& block) {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->changed.wait(lock, [this]() { return !this->filled.empty() || this->closed; });
+        if (this->filled.empty()) {
+            return false;
+        }
+
+        block = this->filled.front();
+        this->filled.pop_front();
+        return true;
+    }
+
+    void release(const Block& block) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->free.push_back(block.data);
+        this->changed.notify_all();
+    }
+
+    void stop() {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopped = true;
+        this->changed.notify_all();
+    }
+
+    bool hasFailed() {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->failed;
+    }
+private:
+    std::unique_ptr<char[]> storage;
+    size_t blockSize = 0;
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<char *> free;
+    std::deque<Block> filled;
+    bool closed = false;
+    bool failed = false;
+    bool stopped = false;
+};
+
+void
+readBlocks(BlockFile& file, BlockQueue& queue)
+{
+    unsigned long long offset = 0;
+    while (char *data = queue.acquire()) {
+        size_t size = 0;
+        while (size < queue.getBlockSize()) {
+            long long count = file.read(data + size, queue.getBlockSize() - size, offset + size);
+            if (count < 0) {
+                queue.close(true);
+                return;
+            }
+
+            if (count == 0) {
+                break;
+            }
+
+            size += static_cast<size_t>(count);
+        }
+
+        if (size == 0) {
+            break;
+        }
+
+        queue.push(data, size);
+        offset += size;
+    }
+
+    queue.close(false);
+}
+
+}
+
+YAML::AsyncFileParser::AsyncFileParser(AbstractEventObserver *eventObserver, size_t blockSize,
+        size_t blockCount)
+    : parser(eventObserver),
+      blockSize(std::max<size_t>(blockSize, 1)),
+      blockCount(std::max<size_t>(blockCount, 2))
+{
+}
+
+YAML::AsyncFileParser::AsyncFileParser(AbstractEventViewObserver *eventObserver, size_t blockSize,
+        size_t blockCount)
+    : parser(eventObserver),
+      blockSize(std::max<size_t>(blockSize, 1)),
+      blockCount(std::max<size_t>(blockCount, 2))
+{
+}
+
+bool
+YAML::AsyncFileParser::parseFile(const std::string& path)
+{
+    BlockFile file(path);
+    if (!file.isOpen()) {
+        return false;
+    }
+
+    this->parser.reset();
+
+    BlockQueue queue(this->blockSize, this->blockCount);
+    std::thread reader(readBlocks, std::ref(file), std::ref(queue));
+
+    bool result = true;
+    BlockQueue::Block block;
+    while (result && queue.pop(block)) {
+        result = this->parser.feed(block.data, block.size);
+        queue.release(block);
+    }
+
+    queue.stop();
+    reader.join();
+
+    result = this->parser.finish() && result;
+    return result && !queue.hasFailed();
+}
+
+const YAML::ParseError&
+YAML::AsyncFileParser::getError() const
+{
+    return this->parser.getError();
+}
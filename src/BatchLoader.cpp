@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include "BatchLoader.h"
+#include "MappedFile.h"
+#include "Parser.h"
+
+namespace {
+
+// Inputs are split into one contiguous range per worker. A worker takes
+// items from the front of its own range and, once it is empty, steals from
+// the back of the others. Both ends of a range share one atomic word so
+// either operation is a single compare-and-swap.
+class WorkQueue {
+public:
+    WorkQueue(size_t count, unsigned workers)
+        : ranges(new std::atomic<uint64_t>[workers]),
+          workers(workers)
+    {
+        for (unsigned i = 0; i < workers; ++i) {
+            this->ranges[i].store(pack(count * i / workers, count * (i + 1) / workers));
+        }
+    }
+
+    bool next(unsigned worker, size_t& item) {
+        if (take(this->ranges[worker], false, item)) {
+            return true;
+        }
+
+        for (unsigned i = 1; i < this->workers; ++i) {
+            if (take(this->ranges[(worker + i) % this->workers], true, item)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+private:
+    static uint64_t pack(uint64_t begin, uint64_t end) {
+        return (begin << 32) | end;
+    }
+
+    static bool take(std::atomic<uint64_t>& range, bool back, size_t& item) {
+        uint64_t value = range.load();
+        for (;;) {
+            uint64_t begin = value >> 32;
+            uint64_t end = value & 0xffffffffu;
+            if (begin >= end) {
+                return false;
+            }
+
+            uint64_t taken = back ? pack(begin, end - 1) : pack(begin + 1, end);
+            if (range.compare_exchange_weak(value, taken)) {
+                item = static_cast<size_t>(back ? end - 1 : begin);
+                return true;
+            }
+        }
+    }
+private:
+    std::unique_ptr<std::atomic<uint64_t>[]> ranges;
+    unsigned workers = 1;
+};
+
+// Parser state reused for every input a worker loads
+class Worker {
+public:
+    Worker(YAML::DocumentBuilder::Strings strings)
+        : builder(scratch, strings),
+          parser(&builder)
+    {
+    }
+
+    void load(YAML::BatchLoader::Result& result, const char *data, size_t length) {
+        this->builder.reset(result.document);
+        this->parser.reset();
+        if (!this->parser.parse(data, length)) {
+            result.status = YAML::BatchLoader::Status::ParseFailed;
+            result.error = this->parser.getError();
+        }
+    }
+private:
+    YAML::Document scratch;
+    YAML::DocumentBuilder builder;
+    YAML::Parser parser;
+};
+
+}
+
+YAML::BatchLoader::BatchLoader(unsigned threads)
+    : threads(threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency()))
+{
+}
+
+std::vector<YAML::BatchLoader::Result>
+YAML::BatchLoader::loadFiles(const std::vector<std::string>& paths)
+{
+    std::vector<Result> results(paths.size());
+    run(paths.size(), DocumentBuilder::Strings::Copy, [&paths, &results](Worker& worker, size_t i) {
+        Result& result = results[i];
+
+        MappedFile file;
+        if (!file.open(paths[i])) {
+            result.status = Status::OpenFailed;
+            return;
+        }
+
+        worker.load(result, file.getData(), file.getSize());
+    });
+
+    return results;
+}
+
+std::vector<YAML::BatchLoader::Result>
+YAML::BatchLoader::loadBuffers(const std::vector<std::string_view>& buffers,
+        DocumentBuilder::Strings strings)
+{
+    std::vector<Result> results(buffers.size());
+    run(buffers.size(), strings, [&buffers, &results](Worker& worker, size_t i) {
+        worker.load(results[i], buffers[i].data(), buffers[i].size());
+    });
+
+    return results;
+}
+
+template <typename Load>
+void
+YAML::BatchLoader::run(size_t count, DocumentBuilder::Strings strings, Load load)
+{
+    unsigned workers = static_cast<unsigned>(std::min<size_t>(this->threads, count));
+    if (workers <= 1) {
+        Worker worker(strings);
+        for (size_t i = 0; i < count; ++i) {
+            load(worker, i);
+        }
+
+        return;
+    }
+
+    WorkQueue queue(count, workers);
+    auto work = [&queue, &load, strings](unsigned index) {
+        Worker worker(strings);
+        size_t item = 0;
+        while (queue.next(index, item)) {
+            load(worker, item);
+        }
+    };
+
+    // The calling thread is worker 0
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < workers; ++i) {
+        pool.emplace_back(work, i);
+    }
+
+    work(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
@@ -0,0 +1,69 @@
+#include "BatchParser.h"
+#include "MappedFile.h"
+
+YAML::EventBatcher::EventBatcher(AbstractEventBatchObserver *eventObserver, size_t batchSize)
+    : eventObserver(eventObserver),
+      batchSize(batchSize != 0 ? batchSize : 1)
+{
+    this->records.reserve(this->batchSize);
+}
+
+void
+YAML::EventBatcher::setBase(const char *base)
+{
+    flush();
+    this->base = base;
+}
+
+void
+YAML::EventBatcher::flush()
+{
+    if (!this->records.empty() && this->eventObserver != nullptr) {
+        this->eventObserver->newEvents(this->base, this->records.data(), this->records.size());
+    }
+
+    this->records.clear();
+}
+
+void
+YAML::EventBatcher::newScalarChunk(std::string_view chunk, bool last)
+{
+    this->blockScalar.append(chunk);
+    if (last) {
+        flush();
+
+        EventRecord record = {0, static_cast<uint32_t>(this->blockScalar.size()), 0, EventRecord::Kind::Scalar};
+        if (this->eventObserver != nullptr) {
+            this->eventObserver->newEvents(this->blockScalar.data(), &record, 1);
+        }
+
+        this->blockScalar.clear();
+    }
+}
+
+YAML::BatchParser::BatchParser(AbstractEventBatchObserver *eventObserver, size_t batchSize)
+    : batcher(eventObserver, batchSize),
+      parser(&batcher)
+{
+}
+
+bool
+YAML::BatchParser::parse(const char *data, size_t length)
+{
+    this->batcher.setBase(data);
+    bool result = this->parser.parse(data, length);
+    this->batcher.flush();
+
+    return result;
+}
+
+bool
+YAML::BatchParser::parseFile(const std::string& path)
+{
+    MappedFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+
+    return parse(file.getData(), file.getSize());
+}
@@ -0,0 +1,146 @@
+#include "Document.h"
+
+YAML::Node::Type
+YAML::Node::getType() const
+{
+    return this->type;
+}
+
+bool
+YAML::Node::isNull() const
+{
+    return this->type == Type::Null;
+}
+
+bool
+YAML::Node::isScalar() const
+{
+    return this->type == Type::Scalar;
+}
+
+bool
+YAML::Node::isMap() const
+{
+    return this->type == Type::Map;
+}
+
+bool
+YAML::Node::isSequence() const
+{
+    return this->type == Type::Sequence;
+}
+
+std::string_view
+YAML::Node::getKey() const
+{
+    return this->key;
+}
+
+std::string_view
+YAML::Node::getValue() const
+{
+    return this->value;
+}
+
+YAML::ScalarValue
+YAML::Node::getScalarValue() const
+{
+    return ScalarValue::classify(this->value);
+}
+
+size_t
+YAML::Node::size() const
+{
+    return this->childCount;
+}
+
+const YAML::Node *
+YAML::Node::getFirstChild() const
+{
+    return this->firstChild;
+}
+
+const YAML::Node *
+YAML::Node::getNext() const
+{
+    return this->next;
+}
+
+const YAML::Node *
+YAML::Node::find(std::string_view key) const
+{
+    for (const Node *child = this->firstChild; child != nullptr; child = child->next) {
+        if (child->key == key) {
+            return child;
+        }
+    }
+
+    return nullptr;
+}
+
+const YAML::Node *
+YAML::Node::at(size_t index) const
+{
+    const Node *child = this->firstChild;
+    while (child != nullptr && index-- != 0) {
+        child = child->next;
+    }
+
+    return child;
+}
+
+YAML::Document::Document()
+    : root(arena.create<Node>())
+{
+}
+
+YAML::Document::Document(Document&& other) noexcept
+    : arena(std::move(other.arena)),
+      root(other.root)
+{
+    other.root = nullptr;
+}
+
+YAML::Document&
+YAML::Document::operator=(Document&& other) noexcept
+{
+    if (this != &other) {
+        this->arena = std::move(other.arena);
+        this->root = other.root;
+        other.root = nullptr;
+    }
+
+    return *this;
+}
+
+const YAML::Node *
+YAML::Document::getRoot() const
+{
+    return this->root;
+}
+
+const YAML::Node *
+YAML::Document::find(std::string_view path) const
+{
+    const Node *node = this->root;
+    while (node != nullptr && !path.empty()) {
+        auto separator = path.find('/');
+        node = node->find(path.substr(0, separator));
+        path = separator != std::string_view::npos ? path.substr(separator + 1) : std::string_view();
+    }
+
+    return node;
+}
+
+void
+YAML::Document::clear()
+{
+    this->arena.clear();
+    this->root = this->arena.create<Node>();
+}
+
+YAML::Arena&
+YAML::Document::getArena()
+{
+    return this->arena;
+}
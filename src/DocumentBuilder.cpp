@@ -0,0 +1,173 @@
+#include "DocumentBuilder.h"
+
+namespace {
+
+// Splits text shaped like a map item: a key without spaces or ':',
+// optional spaces, then ':' followed by a space or the end.
+bool
+splitMapItem(std::string_view text, std::string_view& key, std::string_view& value)
+{
+    size_t keyEnd = 0;
+    while (keyEnd < text.size() && text[keyEnd] != ' ' && text[keyEnd] != '\t' && text[keyEnd] != ':') {
+        ++keyEnd;
+    }
+
+    size_t colon = keyEnd;
+    while (colon < text.size() && (text[colon] == ' ' || text[colon] == '\t')) {
+        ++colon;
+    }
+
+    if (keyEnd == 0 || colon == text.size() || text[colon] != ':' ||
+            (colon + 1 != text.size() && text[colon + 1] != ' ' && text[colon + 1] != '\t')) {
+        return false;
+    }
+
+    size_t valueBegin = colon + 1;
+    while (valueBegin < text.size() && (text[valueBegin] == ' ' || text[valueBegin] == '\t')) {
+        ++valueBegin;
+    }
+
+    key = text.substr(0, keyEnd);
+    value = text.substr(valueBegin);
+    return true;
+}
+
+}
+
+YAML::DocumentBuilder::DocumentBuilder(Document& document, Strings strings)
+    : document(&document),
+      strings(strings)
+{
+}
+
+void
+YAML::DocumentBuilder::reset(Document& document)
+{
+    this->document = &document;
+    this->levels.clear();
+    this->current = nullptr;
+    this->blockScalar.clear();
+}
+
+void
+YAML::DocumentBuilder::newMapItem(std::string_view name, int spaces)
+{
+    this->current = appendItem(openContainer(Node::Type::Map, spaces), name);
+}
+
+void
+YAML::DocumentBuilder::newScalar(std::string_view scalar)
+{
+    setScalar(store(scalar));
+}
+
+void
+YAML::DocumentBuilder::newSequenceItem(int spaces)
+{
+    this->current = appendItem(openContainer(Node::Type::Sequence, spaces), std::string_view());
+}
+
+void
+YAML::DocumentBuilder::newScalarChunk(std::string_view chunk, bool last)
+{
+    this->blockScalar.append(chunk);
+    if (last) {
+        setScalar(this->document->arena.copy(this->blockScalar));
+        this->blockScalar.clear();
+    }
+}
+
+YAML::Node *
+YAML::DocumentBuilder::openContainer(Node::Type type, int spaces)
+{
+    bool popped = false;
+    Level lastPopped = {nullptr, 0};
+    while (!this->levels.empty()) {
+        const Level& level = this->levels.back();
+        if (level.spaces < spaces) {
+            break;
+        }
+
+        if (level.spaces == spaces) {
+            if (level.node->type == type) {
+                return level.node;
+            }
+
+            // "key:" followed by "- item" at the same indentation
+            if (type == Node::Type::Sequence && level.node->type == Node::Type::Map &&
+                    this->current == level.node->lastChild && this->current->type == Node::Type::Null) {
+                break;
+            }
+        }
+
+        popped = true;
+        lastPopped = level;
+        this->levels.pop_back();
+    }
+
+    // A sibling indented less than the container it belongs to, like the
+    // first key on the line after a bare "-"
+    if (popped && lastPopped.node->type == type && lastPopped.spaces > spaces) {
+        this->levels.push_back({lastPopped.node, spaces});
+        return lastPopped.node;
+    }
+
+    Node *node = this->levels.empty() ? this->document->root : this->current;
+    if (node->type == Node::Type::Null || node->type == Node::Type::Scalar) {
+        std::string_view scalar = node->value;
+        node->type = type;
+        node->value = std::string_view();
+
+        // The parser delivers the line after a bare "key:" as the scalar of
+        // the key; when it is shaped like a map item it is the first entry.
+        // Any other scalar, like an anchor on the key line, stays the value
+        // of the container.
+        std::string_view key;
+        std::string_view value;
+        if (type == Node::Type::Map && splitMapItem(scalar, key, value)) {
+            Node *item = appendItem(node, key);
+            if (!value.empty()) {
+                item->type = Node::Type::Scalar;
+                item->value = value;
+            }
+        } else {
+            node->value = scalar;
+        }
+    }
+
+    this->levels.push_back({node, spaces});
+    return node;
+}
+
+YAML::Node *
+YAML::DocumentBuilder::appendItem(Node *container, std::string_view key)
+{
+    Node *item = this->document->arena.create<Node>();
+    item->key = store(key);
+
+    if (container->lastChild != nullptr) {
+        container->lastChild->next = item;
+    } else {
+        container->firstChild = item;
+    }
+
+    container->lastChild = item;
+    ++container->childCount;
+    return item;
+}
+
+void
+YAML::DocumentBuilder::setScalar(std::string_view value)
+{
+    Node *node = this->current != nullptr ? this->current : this->document->root;
+    if (node != nullptr && (node->type == Node::Type::Null || node->type == Node::Type::Scalar)) {
+        node->type = Node::Type::Scalar;
+        node->value = value;
+    }
+}
+
+std::string_view
+YAML::DocumentBuilder::store(std::string_view value)
+{
+    return this->strings == Strings::Copy ? this->document->arena.copy(value) : value;
+}
@@ -0,0 +1,207 @@
+#include <cstring>
+#include <fstream>
+
+#include "EventCache.h"
+#include "KeyTable.h"
+#include "Parser.h"
+
+static_assert(sizeof(YAML::EventCacheHeader) % alignof(YAML::EventRecord) == 0,
+        "records must be aligned after the header");
+
+void
+YAML::EventCacheWriter::newMapItem(std::string_view name, int spaces)
+{
+    add(EventRecord::Kind::MapItem, name, spaces);
+}
+
+void
+YAML::EventCacheWriter::newScalar(std::string_view scalar)
+{
+    add(EventRecord::Kind::Scalar, scalar, 0);
+}
+
+void
+YAML::EventCacheWriter::newSequenceItem(int spaces)
+{
+    add(EventRecord::Kind::SequenceItem, std::string_view(), spaces);
+}
+
+bool
+YAML::EventCacheWriter::save(const std::string& path, uint64_t contentHash) const
+{
+    EventCacheHeader header = {};
+    std::memcpy(header.magic, EventCacheHeader::Magic, sizeof(header.magic));
+    header.version = EventCacheHeader::CurrentVersion;
+    header.byteOrder = EventCacheHeader::ByteOrderMark;
+    header.recordSize = sizeof(EventRecord);
+    header.contentHash = contentHash;
+    header.eventCount = this->records.size();
+    header.textSize = this->text.size();
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(this->records.data()), this->records.size() * sizeof(EventRecord));
+    file.write(this->text.data(), this->text.size());
+    file.close();
+
+    return !file.fail();
+}
+
+void
+YAML::EventCacheWriter::clear()
+{
+    this->records.clear();
+    this->text.clear();
+}
+
+bool
+YAML::EventCacheWriter::write(const char *data, size_t length, const std::string& path)
+{
+    EventCacheWriter writer;
+    Parser parser(&writer);
+
+    return parser.parse(data, length) && writer.save(path, EventCache::hash(data, length));
+}
+
+void
+YAML::EventCacheWriter::add(EventRecord::Kind kind, std::string_view text, int spaces)
+{
+    // Zeroed so no uninitialized padding reaches the file
+    EventRecord record = {};
+    record.offset = this->text.size();
+    record.length = static_cast<uint32_t>(text.size());
+    record.spaces = spaces;
+    record.kind = kind;
+    this->records.push_back(record);
+
+    this->text.append(text);
+}
+
+YAML::EventCache::EventCache(const std::string& path)
+{
+    open(path);
+}
+
+bool
+YAML::EventCache::open(const std::string& path)
+{
+    close();
+    if (!this->file.open(path)) {
+        return false;
+    }
+
+    const char *data = this->file.getData();
+    this->header = reinterpret_cast<const EventCacheHeader *>(data);
+    this->records = reinterpret_cast<const EventRecord *>(data + sizeof(EventCacheHeader));
+    if (!validate()) {
+        close();
+        return false;
+    }
+
+    this->text = data + sizeof(EventCacheHeader) + this->header->eventCount * sizeof(EventRecord);
+    return true;
+}
+
+void
+YAML::EventCache::close()
+{
+    this->file.close();
+    this->header = nullptr;
+    this->records = nullptr;
+    this->text = nullptr;
+}
+
+bool
+YAML::EventCache::isOpen() const
+{
+    return this->header != nullptr;
+}
+
+bool
+YAML::EventCache::matches(const char *data, size_t length) const
+{
+    return isOpen() && this->header->contentHash == hash(data, length);
+}
+
+uint64_t
+YAML::EventCache::getContentHash() const
+{
+    return isOpen() ? this->header->contentHash : 0;
+}
+
+size_t
+YAML::EventCache::getEventCount() const
+{
+    return isOpen() ? this->header->eventCount : 0;
+}
+
+void
+YAML::EventCache::replay(AbstractEventViewObserver *eventObserver) const
+{
+    if (!isOpen() || eventObserver == nullptr) {
+        return;
+    }
+
+    for (size_t i = 0; i < this->header->eventCount; ++i) {
+        const EventRecord& record = this->records[i];
+        switch (record.kind) {
+            case EventRecord::Kind::MapItem:
+                eventObserver->newMapItem(std::string_view(this->text + record.offset, record.length), record.spaces);
+                break;
+            case EventRecord::Kind::Scalar:
+                eventObserver->newScalar(std::string_view(this->text + record.offset, record.length));
+                break;
+            case EventRecord::Kind::SequenceItem:
+                eventObserver->newSequenceItem(record.spaces);
+                break;
+        }
+    }
+}
+
+void
+YAML::EventCache::replay(AbstractEventBatchObserver *eventObserver) const
+{
+    if (isOpen() && eventObserver != nullptr && this->header->eventCount != 0) {
+        eventObserver->newEvents(this->text, this->records, this->header->eventCount);
+    }
+}
+
+uint64_t
+YAML::EventCache::hash(const char *data, size_t length)
+{
+    return KeyTable::hash(std::string_view(data, length));
+}
+
+bool
+YAML::EventCache::validate() const
+{
+    size_t size = this->file.getSize();
+    if (size < sizeof(EventCacheHeader)) {
+        return false;
+    }
+
+    const EventCacheHeader& header = *this->header;
+    if (std::memcmp(header.magic, EventCacheHeader::Magic, sizeof(header.magic)) != 0 ||
+            header.version != EventCacheHeader::CurrentVersion ||
+            header.byteOrder != EventCacheHeader::ByteOrderMark ||
+            header.recordSize != sizeof(EventRecord)) {
+        return false;
+    }
+
+    size_t available = size - sizeof(EventCacheHeader);
+    if (header.eventCount > available / sizeof(EventRecord) ||
+            header.textSize != available - header.eventCount * sizeof(EventRecord)) {
+        return false;
+    }
+
+    // Checked once here so replay can trust every record
+    for (size_t i = 0; i < header.eventCount; ++i) {
+        const EventRecord& record = this->records[i];
+        if (record.kind > EventRecord::Kind::SequenceItem ||
+                record.offset > header.textSize || record.length > header.textSize - record.offset) {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,32 @@
+#include "EventObserverAdapter.h"
+
+YAML::EventObserverAdapter::EventObserverAdapter(AbstractEventObserver *eventObserver)
+    : eventObserver(eventObserver)
+{
+}
+
+void
+YAML::EventObserverAdapter::newMapItem(std::string_view name, int spaces)
+{
+    if (this->eventObserver != nullptr) {
+        this->buffer.assign(name);
+        this->eventObserver->newMapItem(this->buffer, spaces);
+    }
+}
+
+void
+YAML::EventObserverAdapter::newScalar(std::string_view scalar)
+{
+    if (this->eventObserver != nullptr) {
+        this->buffer.assign(scalar);
+        this->eventObserver->newScalar(this->buffer);
+    }
+}
+
+void
+YAML::EventObserverAdapter::newSequenceItem(int spaces)
+{
+    if (this->eventObserver != nullptr) {
+        this->eventObserver->newSequenceItem(spaces);
+    }
+}
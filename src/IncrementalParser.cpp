@@ -0,0 +1,240 @@
+#include <algorithm>
+#include <cstring>
+
+#include "IncrementalParser.h"
+
+void
+YAML::IncrementalParser::EventRecorder::setEvents(std::vector<ParsedEvent> *events)
+{
+    this->events = events;
+}
+
+void
+YAML::IncrementalParser::EventRecorder::newMapItem(std::string_view name, int spaces)
+{
+    this->events->push_back({ParsedEvent::Type::MapItem, std::string(name), spaces});
+}
+
+void
+YAML::IncrementalParser::EventRecorder::newScalar(std::string_view scalar)
+{
+    this->events->push_back({ParsedEvent::Type::Scalar, std::string(scalar), 0});
+}
+
+void
+YAML::IncrementalParser::EventRecorder::newSequenceItem(int spaces)
+{
+    this->events->push_back({ParsedEvent::Type::SequenceItem, std::string(), spaces});
+}
+
+YAML::IncrementalParser::IncrementalParser()
+    : lineParser(&recorder)
+{
+}
+
+bool
+YAML::IncrementalParser::parse(const char *data, size_t length)
+{
+    this->lines.clear();
+    this->events.clear();
+    this->length = length;
+    this->parsedLines = 0;
+    this->lineParser.reset();
+
+    this->valid = parseLines(data, length, 0, length, this->lines, this->events);
+    this->endIdle = this->lineParser.isIdle();
+    this->valid = this->valid && finish(this->events);
+
+    return this->valid;
+}
+
+bool
+YAML::IncrementalParser::update(const char *data, size_t length, size_t offset, size_t removed, size_t inserted,
+        AbstractEventDiffObserver *diffObserver)
+{
+    if (!this->valid || offset + removed > this->length || length + removed != this->length + inserted) {
+        return reparse(data, length, diffObserver);
+    }
+
+    // Whole lines around the edit, starting where no state is carried in
+    size_t first = findLine(offset);
+    size_t last = findLine(offset + removed);
+    while (first > 0 && !isIdleBefore(first)) {
+        --first;
+    }
+
+    size_t begin = first < this->lines.size() ? this->lines[first].offset : this->length;
+    size_t end = last < this->lines.size() ? this->lines[last].offset + this->lines[last].length : this->length;
+    size_t next = std::min(last + 1, this->lines.size());
+
+    std::vector<Line> newLines;
+    std::vector<ParsedEvent> newEvents;
+
+    this->parsedLines = 0;
+    this->lineParser.reset();
+    if (!parseLines(data, length, begin, end + inserted - removed, newLines, newEvents)) {
+        return reparse(data, length, diffObserver);
+    }
+
+    // The following lines are unchanged but may start in a different state
+    while (next < this->lines.size() && !(this->lineParser.isIdle() && this->lines[next].idle)) {
+        const Line& line = this->lines[next++];
+        if (!parseLine(data, line.offset + inserted - removed, line.length, newLines, newEvents)) {
+            return reparse(data, length, diffObserver);
+        }
+    }
+
+    if (next == this->lines.size()) {
+        this->endIdle = this->lineParser.isIdle();
+        if (!finish(newEvents)) {
+            return reparse(data, length, diffObserver);
+        }
+    }
+
+    size_t firstEvent = first < this->lines.size() ? this->lines[first].firstEvent : this->events.size();
+    size_t nextEvent = next < this->lines.size() ? this->lines[next].firstEvent : this->events.size();
+
+    diff(this->events.data() + firstEvent, nextEvent - firstEvent, newEvents.data(), newEvents.size(),
+            firstEvent, diffObserver);
+
+    for (auto& line : newLines) {
+        line.firstEvent += firstEvent;
+    }
+
+    for (size_t i = next; i < this->lines.size(); ++i) {
+        this->lines[i].offset += inserted - removed;
+        this->lines[i].firstEvent += newEvents.size() - (nextEvent - firstEvent);
+    }
+
+    this->lines.erase(this->lines.begin() + first, this->lines.begin() + next);
+    this->lines.insert(this->lines.begin() + first, newLines.begin(), newLines.end());
+
+    this->events.erase(this->events.begin() + firstEvent, this->events.begin() + nextEvent);
+    this->events.insert(this->events.begin() + firstEvent,
+            std::make_move_iterator(newEvents.begin()), std::make_move_iterator(newEvents.end()));
+
+    this->length = length;
+    return true;
+}
+
+const std::vector<YAML::ParsedEvent>&
+YAML::IncrementalParser::getEvents() const
+{
+    return this->events;
+}
+
+size_t
+YAML::IncrementalParser::getLineCount() const
+{
+    return this->lines.size();
+}
+
+size_t
+YAML::IncrementalParser::getParsedLines() const
+{
+    return this->parsedLines;
+}
+
+bool
+YAML::IncrementalParser::parseLines(const char *data, size_t length, size_t begin, size_t end,
+        std::vector<Line>& lines, std::vector<ParsedEvent>& events)
+{
+    while (begin < end) {
+        const char *lineEnd = static_cast<const char *>(std::memchr(data + begin, '\n', end - begin));
+        size_t lineLength = lineEnd != nullptr ? lineEnd - (data + begin) : end - begin;
+        if (!parseLine(data, begin, lineLength, lines, events)) {
+            return false;
+        }
+
+        begin += lineLength + 1;
+    }
+
+    // The last line of the range is empty but followed by a line break
+    return begin != end || end == length || parseLine(data, begin, 0, lines, events);
+}
+
+bool
+YAML::IncrementalParser::parseLine(const char *data, size_t offset, size_t length,
+        std::vector<Line>& lines, std::vector<ParsedEvent>& events)
+{
+    lines.push_back({offset, length, events.size(), this->lineParser.isIdle()});
+    ++this->parsedLines;
+
+    this->recorder.setEvents(&events);
+    return this->lineParser.parse(data + offset, length);
+}
+
+bool
+YAML::IncrementalParser::finish(std::vector<ParsedEvent>& events)
+{
+    this->recorder.setEvents(&events);
+    return this->lineParser.finish();
+}
+
+size_t
+YAML::IncrementalParser::findLine(size_t offset) const
+{
+    auto found = std::upper_bound(this->lines.begin(), this->lines.end(), offset,
+            [](size_t value, const Line& line) { return value < line.offset; });
+
+    if (found == this->lines.begin()) {
+        return 0;
+    }
+
+    size_t line = found - this->lines.begin() - 1;
+    return offset <= this->lines[line].offset + this->lines[line].length ? line : line + 1;
+}
+
+bool
+YAML::IncrementalParser::isIdleBefore(size_t line) const
+{
+    return line < this->lines.size() ? this->lines[line].idle : this->endIdle;
+}
+
+bool
+YAML::IncrementalParser::reparse(const char *data, size_t length, AbstractEventDiffObserver *diffObserver)
+{
+    std::vector<ParsedEvent> previous;
+    previous.swap(this->events);
+
+    bool result = parse(data, length);
+    diff(previous.data(), previous.size(), this->events.data(), this->events.size(), 0, diffObserver);
+
+    return result;
+}
+
+void
+YAML::IncrementalParser::diff(const ParsedEvent *before, size_t beforeCount, const ParsedEvent *after, size_t afterCount,
+        size_t index, AbstractEventDiffObserver *diffObserver)
+{
+    if (diffObserver == nullptr) {
+        return;
+    }
+
+    // Only the part between the common prefix and suffix is reported
+    while (beforeCount > 0 && afterCount > 0 && *before == *after) {
+        ++before;
+        ++after;
+        --beforeCount;
+        --afterCount;
+        ++index;
+    }
+
+    while (beforeCount > 0 && afterCount > 0 && before[beforeCount - 1] == after[afterCount - 1]) {
+        --beforeCount;
+        --afterCount;
+    }
+
+    size_t common = std::min(beforeCount, afterCount);
+    for (size_t i = 0; i < common; ++i) {
+        diffObserver->eventChanged(index++, before[i], after[i]);
+    }
+
+    for (size_t i = common; i < beforeCount; ++i) {
+        diffObserver->eventRemoved(index, before[i]);
+    }
+
+    for (size_t i = common; i < afterCount; ++i) {
+        diffObserver->eventAdded(index++, after[i]);
+    }
+}
@@ -0,0 +1,36 @@
+#include "KeyInterningAdapter.h"
+
+YAML::KeyInterningAdapter::KeyInterningAdapter(KeyTable& keys, AbstractKeyEventObserver *eventObserver)
+    : keys(keys),
+      eventObserver(eventObserver)
+{
+}
+
+void
+YAML::KeyInterningAdapter::newMapItem(std::string_view name, int spaces)
+{
+    if (this->eventObserver != nullptr) {
+        if (const KeyTable::Key *key = this->keys.intern(name)) {
+            this->eventObserver->newMapItem(*key, spaces);
+        } else {
+            const KeyTable::Key fallback{name, KeyTable::hash(name), KeyTable::NoId};
+            this->eventObserver->newMapItem(fallback, spaces);
+        }
+    }
+}
+
+void
+YAML::KeyInterningAdapter::newScalar(std::string_view scalar)
+{
+    if (this->eventObserver != nullptr) {
+        this->eventObserver->newScalar(scalar);
+    }
+}
+
+void
+YAML::KeyInterningAdapter::newSequenceItem(int spaces)
+{
+    if (this->eventObserver != nullptr) {
+        this->eventObserver->newSequenceItem(spaces);
+    }
+}
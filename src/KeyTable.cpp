@@ -0,0 +1,172 @@
+#include <algorithm>
+
+#include "KeyTable.h"
+
+YAML::KeyTable::Slots::Slots(size_t capacity)
+    : mask(capacity - 1),
+      keys(new std::atomic<const Key *>[capacity])
+{
+    for (size_t i = 0; i < capacity; ++i) {
+        this->keys[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+YAML::KeyTable::KeyTable(size_t maxKeys)
+    : count(0),
+      maxKeys(std::min(maxKeys, MaxKeys))
+{
+    for (auto& segment : this->segments) {
+        segment.store(nullptr, std::memory_order_relaxed);
+    }
+
+    this->tables.push_back(std::make_unique<Slots>(FirstSegmentSize * 2));
+    this->slots.store(this->tables.back().get(), std::memory_order_release);
+}
+
+YAML::KeyTable::~KeyTable()
+{
+    for (auto& segment : this->segments) {
+        delete[] segment.load(std::memory_order_relaxed);
+    }
+}
+
+const YAML::KeyTable::Key *
+YAML::KeyTable::intern(std::string_view name)
+{
+    uint64_t hash = KeyTable::hash(name);
+    if (const Key *key = find(this->slots.load(std::memory_order_acquire), name, hash)) {
+        return key;
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    // Another thread may have added it while we waited
+    if (const Key *key = find(this->slots.load(std::memory_order_relaxed), name, hash)) {
+        return key;
+    }
+
+    uint32_t id = this->count.load(std::memory_order_relaxed);
+    if (id >= this->maxKeys) {
+        return nullptr;
+    }
+
+    size_t segment = 0;
+    size_t offset = 0;
+    locate(id, segment, offset);
+
+    const Key **keys = this->segments[segment].load(std::memory_order_relaxed);
+    if (keys == nullptr) {
+        keys = new const Key *[FirstSegmentSize << segment];
+        this->segments[segment].store(keys, std::memory_order_release);
+    }
+
+    Key *key = this->arena.create<Key>();
+    key->name = this->arena.copy(name);
+    key->hash = hash;
+    key->id = id;
+    keys[offset] = key;
+
+    // Keep the table at most half full
+    if ((id + 1) * 2 > this->slots.load(std::memory_order_relaxed)->mask + 1) {
+        grow();
+    }
+
+    insert(this->slots.load(std::memory_order_relaxed), key);
+    this->count.store(id + 1, std::memory_order_release);
+    return key;
+}
+
+const YAML::KeyTable::Key *
+YAML::KeyTable::find(std::string_view name) const
+{
+    return find(this->slots.load(std::memory_order_acquire), name, hash(name));
+}
+
+const YAML::KeyTable::Key *
+YAML::KeyTable::get(uint32_t id) const
+{
+    if (id >= this->count.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+
+    size_t segment = 0;
+    size_t offset = 0;
+    locate(id, segment, offset);
+    return this->segments[segment].load(std::memory_order_acquire)[offset];
+}
+
+size_t
+YAML::KeyTable::size() const
+{
+    return this->count.load(std::memory_order_acquire);
+}
+
+uint64_t
+YAML::KeyTable::hash(std::string_view name)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (char symbol : name) {
+        hash ^= static_cast<unsigned char>(symbol);
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
+const YAML::KeyTable::Key *
+YAML::KeyTable::find(const Slots *slots, std::string_view name, uint64_t hash) const
+{
+    for (size_t i = hash & slots->mask;; i = (i + 1) & slots->mask) {
+        const Key *key = slots->keys[i].load(std::memory_order_acquire);
+        if (key == nullptr) {
+            return nullptr;
+        }
+
+        if (key->hash == hash && key->name == name) {
+            return key;
+        }
+    }
+}
+
+void
+YAML::KeyTable::insert(Slots *slots, const Key *key)
+{
+    size_t i = key->hash & slots->mask;
+    while (slots->keys[i].load(std::memory_order_relaxed) != nullptr) {
+        i = (i + 1) & slots->mask;
+    }
+
+    slots->keys[i].store(key, std::memory_order_release);
+}
+
+void
+YAML::KeyTable::grow()
+{
+    // Readers may still be probing the old table, so it is kept alive and
+    // unchanged until the KeyTable is destroyed
+    const Slots *old = this->slots.load(std::memory_order_relaxed);
+    auto grown = std::make_unique<Slots>((old->mask + 1) * 2);
+    for (size_t i = 0; i <= old->mask; ++i) {
+        if (const Key *key = old->keys[i].load(std::memory_order_relaxed)) {
+            insert(grown.get(), key);
+        }
+    }
+
+    this->slots.store(grown.get(), std::memory_order_release);
+    this->tables.push_back(std::move(grown));
+}
+
+void
+YAML::KeyTable::locate(uint32_t id, size_t& segment, size_t& offset)
+{
+    // Segment k holds FirstSegmentSize << k ids starting at
+    // FirstSegmentSize * (2^k - 1)
+    size_t block = id / FirstSegmentSize + 1;
+    segment = 0;
+    while (block > 1) {
+        block >>= 1;
+        ++segment;
+    }
+
+    offset = id - FirstSegmentSize * ((size_t(1) << segment) - 1);
+}
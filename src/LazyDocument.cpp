@@ -0,0 +1,375 @@
+#include <cstring>
+
+#include "LazyDocument.h"
+#include "AbstractScalarChunkObserver.h"
+#include "FlowTokenizer.h"
+#include "KeyTable.h"
+#include "Parser.h"
+
+namespace {
+
+bool
+isSpace(char symbol)
+{
+    return symbol == ' ' || (symbol >= '\t' && symbol <= '\r');
+}
+
+// Collects the value of a single map item; chunks of a block scalar are
+// joined into storage.
+class ScalarCollector : public YAML::AbstractEventViewObserver, public YAML::AbstractScalarChunkObserver {
+public:
+    ScalarCollector(std::string& storage)
+        : storage(storage)
+    {
+        this->storage.clear();
+    }
+
+    void newMapItem(std::string_view, int) override {
+        ++this->events;
+    }
+
+    void newScalar(std::string_view scalar) override {
+        ++this->events;
+        this->scalar = scalar;
+        this->found = true;
+    }
+
+    void newSequenceItem(int) override {
+        ++this->events;
+    }
+
+    void newScalarChunk(std::string_view chunk, bool last) override {
+        this->storage.append(chunk);
+        if (last) {
+            newScalar(this->storage);
+        }
+    }
+public:
+    std::string& storage;
+    std::string_view scalar;
+    size_t events = 0;
+    bool found = false;
+};
+
+// Flow collections still open after [begin, end), starting with depth
+// open; 0 once the outermost one is closed or the text is malformed
+int
+scanFlow(const char *begin, const char *end, int depth)
+{
+    using Token = YAML::FlowTokenizer::Token;
+
+    YAML::FlowTokenizer tokenizer(begin, end);
+    for (Token token = tokenizer.next(); token != Token::End; token = tokenizer.next()) {
+        switch (token) {
+            case Token::SequenceBegin:
+            case Token::MapBegin:
+                ++depth;
+                break;
+            case Token::SequenceEnd:
+            case Token::MapEnd:
+                if (--depth == 0) {
+                    return 0;
+                }
+                break;
+            case Token::Error:
+                return 0;
+            default:
+                break;
+        }
+    }
+
+    return depth;
+}
+
+}
+
+YAML::LazyDocument::LazyDocument(const char *data, size_t length)
+{
+    load(data, length);
+}
+
+void
+YAML::LazyDocument::load(const char *data, size_t length)
+{
+    this->data = data;
+    this->length = length;
+    this->lines.clear();
+
+    // Lines of a block scalar or of a flow collection spanning lines belong
+    // to the value of the line that opened it and are never keys
+    Continuation continuation;
+    const char *end = data + length;
+    for (const char *position = data; position != end;) {
+        const char *lineEnd = static_cast<const char *>(std::memchr(position, '\n', end - position));
+        if (lineEnd == nullptr) {
+            lineEnd = end;
+        }
+
+        Line line = {};
+        line.offset = static_cast<size_t>(position - data);
+        line.length = static_cast<size_t>(lineEnd - position);
+        if (!continueValue(line, continuation)) {
+            indexLine(line, continuation);
+        }
+        this->lines.push_back(line);
+
+        position = lineEnd != end ? lineEnd + 1 : end;
+    }
+
+    // A block ends at the first following line that is not more indented;
+    // blank and comment lines never end a block.
+    std::vector<size_t> open;
+    for (size_t i = 0; i < this->lines.size(); ++i) {
+        Line& line = this->lines[i];
+        line.next = i + 1;
+        if (line.blank || line.continuation) {
+            continue;
+        }
+
+        while (!open.empty() && this->lines[open.back()].spaces >= line.spaces) {
+            this->lines[open.back()].next = i;
+            open.pop_back();
+        }
+
+        open.push_back(i);
+    }
+
+    for (size_t i : open) {
+        this->lines[i].next = this->lines.size();
+    }
+}
+
+bool
+YAML::LazyDocument::getValue(std::string_view path, std::string_view& value) const
+{
+    size_t index = findLine(path);
+    if (index == NotFound || path.empty()) {
+        return false;
+    }
+
+    // The key and its scalar, and nothing else
+    const Line& line = this->lines[index];
+    const Line& last = this->lines[findValueEnd(index)];
+
+    ScalarCollector collector(this->blockScalar);
+    Parser parser(&collector);
+    if (!parser.parse(this->data + line.offset, last.offset + last.length - line.offset) ||
+            !collector.found || collector.events != 2) {
+        return false;
+    }
+
+    value = collector.scalar;
+    return true;
+}
+
+bool
+YAML::LazyDocument::materialize(std::string_view path, Document& document,
+        DocumentBuilder::Strings strings) const
+{
+    size_t begin = 0;
+    size_t end = this->lines.size();
+    size_t valueOffset = 0;
+    if (!path.empty()) {
+        size_t index = findLine(path);
+        if (index == NotFound) {
+            return false;
+        }
+
+        const Line& line = this->lines[index];
+        begin = index + 1;
+        end = line.next;
+
+        // An inline flow collection is parsed from its opening bracket
+        if (line.flowValue) {
+            begin = index;
+            end = findValueEnd(index) + 1;
+            valueOffset = line.valueOffset;
+        }
+    }
+
+    document.clear();
+    if (begin == end) {
+        return true;
+    }
+
+    size_t offset = this->lines[begin].offset + valueOffset;
+    const Line& last = this->lines[end - 1];
+
+    DocumentBuilder builder(document, strings);
+    Parser parser(&builder);
+    return parser.parse(this->data + offset, last.offset + last.length - offset);
+}
+
+size_t
+YAML::LazyDocument::getLineCount() const
+{
+    return this->lines.size();
+}
+
+void
+YAML::LazyDocument::indexLine(Line& line, Continuation& continuation) const
+{
+    const char *begin = this->data + line.offset;
+    const char *end = begin + line.length;
+
+    const char *position = begin;
+    while (position != end && isSpace(*position)) {
+        ++position;
+    }
+
+    line.spaces = static_cast<int>(position - begin);
+    line.blank = position == end || *position == '#';
+    if (line.blank) {
+        return;
+    }
+
+    // Sequence entries are not keys, but their values may still open a
+    // block scalar or a flow collection
+    bool entry = false;
+    int spaces = line.spaces;
+    while (position != end && *position == '-' && (position + 1 == end || isSpace(position[1]))) {
+        entry = true;
+        spaces = static_cast<int>(position - begin);
+        ++position;
+        while (position != end && isSpace(*position)) {
+            ++position;
+        }
+    }
+
+    // Same shape the state machine accepts for a map item: a run without
+    // spaces or ':', optional spaces, then ':' followed by a space or the
+    // end of the line.
+    const char *keyEnd = position;
+    while (keyEnd != end && !isSpace(*keyEnd) && *keyEnd != ':') {
+        ++keyEnd;
+    }
+
+    const char *colon = keyEnd;
+    while (colon != end && isSpace(*colon)) {
+        ++colon;
+    }
+
+    const char *value = position;
+    if (keyEnd != position && colon != end && *colon == ':' && (colon + 1 == end || isSpace(colon[1]))) {
+        spaces = static_cast<int>(position - begin);
+        value = colon + 1;
+        while (value != end && isSpace(*value)) {
+            ++value;
+        }
+
+        if (!entry) {
+            std::string_view key(position, keyEnd - position);
+            line.hasKey = true;
+            line.keyHash = KeyTable::hash(key);
+            line.keyOffset = static_cast<uint32_t>(position - begin);
+            line.keyLength = static_cast<uint32_t>(key.size());
+        }
+    }
+
+    if (value == end) {
+        return;
+    }
+
+    if (*value == '|' || *value == '>') {
+        const char *header = value + 1;
+        while (header != end && (*header == '+' || *header == '-' || (*header >= '1' && *header <= '9'))) {
+            ++header;
+        }
+
+        if (header == end || isSpace(*header)) {
+            continuation.kind = Continuation::Kind::BlockScalar;
+            continuation.spaces = spaces;
+        }
+    } else if (*value == '[' || *value == '{') {
+        line.flowValue = true;
+        line.valueOffset = static_cast<uint32_t>(value - begin);
+        continuation.depth = scanFlow(value, end, 0);
+        if (continuation.depth != 0) {
+            continuation.kind = Continuation::Kind::FlowCollection;
+        }
+    }
+}
+
+bool
+YAML::LazyDocument::continueValue(Line& line, Continuation& continuation) const
+{
+    const char *begin = this->data + line.offset;
+    const char *end = begin + line.length;
+
+    switch (continuation.kind) {
+        case Continuation::Kind::None:
+            return false;
+        case Continuation::Kind::BlockScalar: {
+            // Blank lines belong to the block whatever their indentation
+            const char *position = begin;
+            while (position != end && isSpace(*position)) {
+                ++position;
+            }
+
+            if (position != end && position - begin <= continuation.spaces) {
+                continuation.kind = Continuation::Kind::None;
+                return false;
+            }
+            break;
+        }
+        case Continuation::Kind::FlowCollection:
+            continuation.depth = scanFlow(begin, end, continuation.depth);
+            if (continuation.depth == 0) {
+                continuation.kind = Continuation::Kind::None;
+            }
+            break;
+    }
+
+    line.continuation = true;
+    return true;
+}
+
+size_t
+YAML::LazyDocument::findLine(std::string_view path) const
+{
+    size_t begin = 0;
+    size_t end = this->lines.size();
+    size_t found = NotFound;
+    while (!path.empty()) {
+        auto separator = path.find('/');
+        std::string_view key = path.substr(0, separator);
+        path = separator != std::string_view::npos ? path.substr(separator + 1) : std::string_view();
+
+        // Children are the lines at the indentation of the first non blank
+        // line in the block; deeper lines are skipped a block at a time.
+        uint64_t hash = KeyTable::hash(key);
+        found = NotFound;
+        for (size_t i = begin; i < end; i = this->lines[i].next) {
+            const Line& line = this->lines[i];
+            if (line.hasKey && line.keyHash == hash && getKey(line) == key) {
+                found = i;
+                break;
+            }
+        }
+
+        if (found == NotFound) {
+            return NotFound;
+        }
+
+        begin = found + 1;
+        end = this->lines[found].next;
+    }
+
+    return found;
+}
+
+size_t
+YAML::LazyDocument::findValueEnd(size_t index) const
+{
+    while (index + 1 < this->lines.size() && this->lines[index + 1].continuation) {
+        ++index;
+    }
+
+    return index;
+}
+
+std::string_view
+YAML::LazyDocument::getKey(const Line& line) const
+{
+    return std::string_view(this->data + line.offset + line.keyOffset, line.keyLength);
+}
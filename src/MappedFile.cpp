@@ -0,0 +1,185 @@
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "MappedFile.h"
+
+YAML::MappedFile::MappedFile(const std::string& path)
+{
+    open(path);
+}
+
+YAML::MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+    swap(other);
+}
+
+YAML::MappedFile::~MappedFile()
+{
+    close();
+}
+
+YAML::MappedFile&
+YAML::MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        close();
+        swap(other);
+    }
+
+    return *this;
+}
+
+#ifdef _WIN32
+
+bool
+YAML::MappedFile::open(const std::string& path)
+{
+    close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    this->file = file;
+    this->opened = true;
+    if (fileSize.QuadPart == 0) {
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        close();
+        return false;
+    }
+
+    this->mapping = mapping;
+    this->data = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (this->data == nullptr) {
+        close();
+        return false;
+    }
+
+    this->size = static_cast<size_t>(fileSize.QuadPart);
+    return true;
+}
+
+void
+YAML::MappedFile::close()
+{
+    if (this->data != nullptr) {
+        UnmapViewOfFile(this->data);
+    }
+
+    if (this->mapping != nullptr) {
+        CloseHandle(this->mapping);
+    }
+
+    if (this->file != nullptr) {
+        CloseHandle(this->file);
+    }
+
+    this->data = nullptr;
+    this->size = 0;
+    this->opened = false;
+    this->file = nullptr;
+    this->mapping = nullptr;
+}
+
+#else
+
+bool
+YAML::MappedFile::open(const std::string& path)
+{
+    close();
+
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file == -1) {
+        return false;
+    }
+
+    struct stat status;
+    if (fstat(file, &status) == -1 || !S_ISREG(status.st_mode)) {
+        ::close(file);
+        return false;
+    }
+
+    size_t fileSize = static_cast<size_t>(status.st_size);
+    if (fileSize != 0) {
+        void *mapping = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, file, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(file);
+            return false;
+        }
+
+        madvise(mapping, fileSize, MADV_SEQUENTIAL);
+
+        this->data = static_cast<const char *>(mapping);
+        this->size = fileSize;
+    }
+
+    // The mapping keeps its own reference to the file
+    ::close(file);
+
+    this->opened = true;
+    return true;
+}
+
+void
+YAML::MappedFile::close()
+{
+    if (this->data != nullptr) {
+        munmap(const_cast<char *>(this->data), this->size);
+    }
+
+    this->data = nullptr;
+    this->size = 0;
+    this->opened = false;
+}
+
+#endif
+
+bool
+YAML::MappedFile::isOpen() const
+{
+    return this->opened;
+}
+
+const char *
+YAML::MappedFile::getData() const
+{
+    return this->data;
+}
+
+size_t
+YAML::MappedFile::getSize() const
+{
+    return this->size;
+}
+
+void
+YAML::MappedFile::swap(MappedFile& other) noexcept
+{
+    std::swap(this->data, other.data);
+    std::swap(this->size, other.size);
+    std::swap(this->opened, other.opened);
+#ifdef _WIN32
+    std::swap(this->file, other.file);
+    std::swap(this->mapping, other.mapping);
+#endif
+}
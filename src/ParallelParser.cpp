@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ParallelParser.h"
+#include "Parser.h"
+#include "AbstractEventViewObserver.h"
+#include "AbstractScalarChunkObserver.h"
+#include "EventObserverAdapter.h"
+#include "MappedFile.h"
+
+namespace {
+
+// Block scalar chunks are recorded as they come; they point into the
+// input lines or at constant strings, so they outlive the parse.
+class EventRecorder : public YAML::AbstractEventViewObserver, public YAML::AbstractScalarChunkObserver {
+public:
+    void newMapItem(std::string_view name, int spaces) override {
+        this->events.push_back({Type::MapItem, name, spaces});
+    }
+
+    void newScalar(std::string_view scalar) override {
+        this->events.push_back({Type::Scalar, scalar, 0});
+    }
+
+    void newSequenceItem(int spaces) override {
+        this->events.push_back({Type::SequenceItem, std::string_view(), spaces});
+    }
+
+    void newScalarChunk(std::string_view chunk, bool last) override {
+        this->events.push_back({Type::ScalarChunk, chunk, last ? 1 : 0});
+    }
+
+    void replay(YAML::AbstractEventViewObserver *eventObserver) {
+        if (eventObserver != nullptr) {
+            auto chunkObserver = dynamic_cast<YAML::AbstractScalarChunkObserver *>(eventObserver);
+            for (const auto& event : this->events) {
+                switch (event.type) {
+                    case Type::MapItem:
+                        eventObserver->newMapItem(event.value, event.spaces);
+                        break;
+                    case Type::Scalar:
+                        eventObserver->newScalar(event.value);
+                        break;
+                    case Type::SequenceItem:
+                        eventObserver->newSequenceItem(event.spaces);
+                        break;
+                    case Type::ScalarChunk:
+                        if (chunkObserver != nullptr) {
+                            chunkObserver->newScalarChunk(event.value, event.spaces != 0);
+                        } else {
+                            this->blockScalar.append(event.value);
+                            if (event.spaces != 0) {
+                                eventObserver->newScalar(this->blockScalar);
+                                this->blockScalar.clear();
+                            }
+                        }
+                        break;
+                }
+            }
+        }
+
+        this->events.clear();
+    }
+private:
+    enum class Type {
+        MapItem,
+        Scalar,
+        SequenceItem,
+        ScalarChunk,
+    };
+
+    struct Event {
+        Type type;
+        std::string_view value;
+        // Indentation, or whether a chunk is the last one
+        int spaces;
+    };
+private:
+    std::vector<Event> events;
+    std::string blockScalar;
+};
+
+class Chunk {
+public:
+    Chunk()
+        : parser(&recorder)
+    {
+    }
+
+    // Chunks are fed so a block scalar can continue into the next one. The
+    // last chunk is finished in place: its unterminated line would otherwise
+    // be copied into the parser and cleared before the events are replayed.
+    bool parse(const char *begin, const char *end, bool last) {
+        return last ? this->parser.finish(begin, end - begin) : this->parser.feed(begin, end - begin);
+    }
+public:
+    EventRecorder recorder;
+    YAML::Parser parser;
+    const char *begin = nullptr;
+    const char *end = nullptr;
+    bool result = false;
+};
+
+// End of the chunk starting at position: at least size bytes, extended to
+// the end of the line.
+const char *
+nextChunk(const char *position, const char *end, size_t size)
+{
+    if (static_cast<size_t>(end - position) <= size) {
+        return end;
+    }
+
+    position += size - 1;
+    const char *newline = static_cast<const char *>(std::memchr(position, '\n', end - position));
+    return newline != nullptr ? newline + 1 : end;
+}
+
+}
+
+YAML::ParallelParser::ParallelParser(AbstractEventObserver *eventObserver, unsigned threads,
+        size_t chunkSize)
+    : ParallelParser(static_cast<AbstractEventViewObserver *>(nullptr), threads, chunkSize)
+{
+    this->observerAdapter = std::make_shared<EventObserverAdapter>(eventObserver);
+    this->eventObserver = this->observerAdapter.get();
+}
+
+YAML::ParallelParser::ParallelParser(AbstractEventViewObserver *eventObserver, unsigned threads,
+        size_t chunkSize)
+    : eventObserver(eventObserver),
+      threads(threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency())),
+      chunkSize(std::max<size_t>(chunkSize, 1))
+{
+}
+
+bool
+YAML::ParallelParser::parse(const char *data, size_t length)
+{
+    if (this->threads == 1 || length == 0) {
+        Parser parser(this->eventObserver);
+        return parser.parse(data, length);
+    }
+
+    const char *end = data + length;
+    auto carry = std::make_unique<Chunk>();
+    while (data != end) {
+        // The first chunk of a wave continues the carried parser on this
+        // thread. The others are parsed speculatively from a fresh state,
+        // which is only right when the chunk before them ends idle; if it
+        // does not, they are parsed again by the carried parser.
+        const char *firstBegin = data;
+        const char *firstEnd = data = nextChunk(data, end, this->chunkSize);
+
+        std::vector<std::unique_ptr<Chunk>> chunks;
+        for (unsigned i = 1; i < this->threads && data != end; ++i) {
+            auto chunk = std::make_unique<Chunk>();
+            chunk->begin = data;
+            chunk->end = data = nextChunk(data, end, this->chunkSize);
+            chunks.push_back(std::move(chunk));
+        }
+
+        std::vector<std::future<void>> tasks;
+        for (auto& chunk : chunks) {
+            tasks.push_back(std::async(std::launch::async, [chunk = chunk.get(), end]() {
+                chunk->result = chunk->parse(chunk->begin, chunk->end, chunk->end == end);
+            }));
+        }
+
+        bool result = carry->parse(firstBegin, firstEnd, firstEnd == end);
+        carry->recorder.replay(this->eventObserver);
+
+        for (auto& task : tasks) {
+            task.wait();
+        }
+
+        if (!result) {
+            return false;
+        }
+
+        for (auto& chunk : chunks) {
+            if (carry->parser.isIdle()) {
+                chunk->recorder.replay(this->eventObserver);
+                if (!chunk->result) {
+                    return false;
+                }
+
+                carry = std::move(chunk);
+            } else {
+                result = carry->parse(chunk->begin, chunk->end, chunk->end == end);
+                carry->recorder.replay(this->eventObserver);
+                if (!result) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+bool
+YAML::ParallelParser::parseFile(const std::string& path)
+{
+    MappedFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+
+    return parse(file.getData(), file.getSize());
+}
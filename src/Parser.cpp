@@ -1,24 +1,69 @@
-#include <sstream>
-
 #include "Parser.h"
-#include "AbstractEventObserver.h"
+#include "EventObserverAdapter.h"
+
+template class YAML::BasicParser<YAML::AbstractEventViewObserver>;
 
 YAML::Parser::Parser(AbstractEventObserver *eventObserver)
-    : lineParser(eventObserver)
+    : observerAdapter(std::make_shared<EventObserverAdapter>(eventObserver)),
+      parser(observerAdapter.get())
+{
+}
+
+YAML::Parser::Parser(AbstractEventViewObserver *eventObserver)
+    : parser(eventObserver)
 {
 }
 
 bool
 YAML::Parser::parse(std::istream& input)
 {
-    std::string line;
-    while (std::getline(input, line)) {
-        std::stringstream localInput(line);
-        localInput.unsetf(std::ios_base::skipws);
-        if (!lineParser.parse(localInput)) {
-            break;
-        }
-    }
+    return parser.parse(input);
+}
+
+bool
+YAML::Parser::parse(const char *data, size_t length)
+{
+    return parser.parse(data, length);
+}
+
+bool
+YAML::Parser::parseFile(const std::string& path)
+{
+    return parser.parseFile(path);
+}
+
+bool
+YAML::Parser::feed(const char *data, size_t length)
+{
+    return parser.feed(data, length);
+}
+
+bool
+YAML::Parser::finish()
+{
+    return parser.finish();
+}
+
+bool
+YAML::Parser::finish(const char *data, size_t length)
+{
+    return parser.finish(data, length);
+}
 
-    return !input.bad() && input.eof();
+bool
+YAML::Parser::isIdle() const
+{
+    return parser.isIdle();
+}
+
+void
+YAML::Parser::reset()
+{
+    parser.reset();
+}
+
+const YAML::ParseError&
+YAML::Parser::getError() const
+{
+    return parser.getError();
 }
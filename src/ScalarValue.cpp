@@ -0,0 +1,158 @@
+#include <charconv>
+#include <limits>
+
+#include "ScalarValue.h"
+
+namespace {
+
+bool
+isDigit(char symbol)
+{
+    return symbol >= '0' && symbol <= '9';
+}
+
+bool
+isOneOf(std::string_view text, std::string_view lower, std::string_view title, std::string_view upper)
+{
+    return text == lower || text == title || text == upper;
+}
+
+// Converts all of [begin, end) or fails
+template <typename T, typename... Args>
+bool
+convert(const char *begin, const char *end, T& value, Args... args)
+{
+    auto result = std::from_chars(begin, end, value, args...);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+}
+
+YAML::ScalarValue
+YAML::ScalarValue::classify(std::string_view text)
+{
+    ScalarValue value;
+    value.text = text;
+    value.type = Type::String;
+
+    // Dispatch on the first character so plain strings are rejected early
+    switch (text.empty() ? '~' : text.front()) {
+        case '~':
+        case 'n':
+        case 'N':
+            if (text.empty() || text == "~" || isOneOf(text, "null", "Null", "NULL")) {
+                value.type = Type::Null;
+            }
+            break;
+        case 't':
+        case 'T':
+        case 'f':
+        case 'F':
+            if (isOneOf(text, "true", "True", "TRUE")) {
+                value.type = Type::Bool;
+                value.boolean = true;
+            } else if (isOneOf(text, "false", "False", "FALSE")) {
+                value.type = Type::Bool;
+            }
+            break;
+        case '+':
+        case '-':
+        case '.':
+        case '0':
+        case '1':
+        case '2':
+        case '3':
+        case '4':
+        case '5':
+        case '6':
+        case '7':
+        case '8':
+        case '9':
+            if (!value.classifyNumber()) {
+                value.type = Type::String;
+            }
+            break;
+    }
+
+    return value;
+}
+
+YAML::ScalarValue::Type
+YAML::ScalarValue::getType() const
+{
+    return this->type;
+}
+
+std::string_view
+YAML::ScalarValue::getText() const
+{
+    return this->text;
+}
+
+bool
+YAML::ScalarValue::getBool() const
+{
+    return this->boolean;
+}
+
+int64_t
+YAML::ScalarValue::getInteger() const
+{
+    return this->integer;
+}
+
+double
+YAML::ScalarValue::getFloat() const
+{
+    return this->type == Type::Integer ? static_cast<double>(this->integer) : this->real;
+}
+
+bool
+YAML::ScalarValue::classifyNumber()
+{
+    const char *begin = this->text.data();
+    const char *end = begin + this->text.size();
+
+    bool negative = *begin == '-';
+    const char *body = *begin == '-' || *begin == '+' ? begin + 1 : begin;
+    std::string_view digits(body, end - body);
+
+    if (body == begin && digits.size() > 2 && digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'o')) {
+        // from_chars would take a sign after the prefix
+        if (digits[2] == '-') {
+            return false;
+        }
+
+        this->type = Type::Integer;
+        return convert(body + 2, end, this->integer, digits[1] == 'x' ? 16 : 8);
+    }
+
+    if (isOneOf(digits, ".inf", ".Inf", ".INF")) {
+        this->type = Type::Float;
+        this->real = negative ? -std::numeric_limits<double>::infinity() :
+            std::numeric_limits<double>::infinity();
+        return true;
+    }
+
+    if (body == begin && isOneOf(digits, ".nan", ".NaN", ".NAN")) {
+        this->type = Type::Float;
+        this->real = std::numeric_limits<double>::quiet_NaN();
+        return true;
+    }
+
+    if (digits.empty() || !(isDigit(digits[0]) || (digits[0] == '.' && digits.size() > 1 && isDigit(digits[1])))) {
+        return false;
+    }
+
+    // from_chars takes '-' but not '+'
+    const char *number = negative ? begin : body;
+    this->type = Type::Integer;
+    if (convert(number, end, this->integer)) {
+        return true;
+    }
+
+    // Fractions, exponents and integers too large for int64_t
+    this->type = Type::Float;
+    this->integer = 0;
+    return convert(number, end, this->real, std::chars_format::general);
+}
@@ -0,0 +1,239 @@
+#include <cstring>
+
+#include "SelectiveParser.h"
+#include "AbstractEventViewObserver.h"
+#include "MappedFile.h"
+
+namespace {
+
+// Whether the state machine may expect more after the line, so the line
+// after it would be parsed in another state: a key or sequence entry
+// without a value, a block scalar header or a flow collection. A comment
+// may hide how the line ends.
+bool
+mayContinue(const char *begin, const char *end)
+{
+    while (end != begin && YAML::InputBuffer::isSpace(end[-1])) {
+        --end;
+    }
+
+    if (end != begin && (end[-1] == ':' || end[-1] == '-')) {
+        return true;
+    }
+
+    for (const char *position = begin; position != end; ++position) {
+        switch (*position) {
+            case '#':
+            case '[':
+            case '{':
+            case '|':
+            case '>':
+                return true;
+            default:
+                break;
+        }
+    }
+
+    return false;
+}
+
+}
+
+YAML::PathFilter::PathFilter(AbstractEventViewObserver *eventObserver)
+    : eventObserver(eventObserver)
+{
+}
+
+void
+YAML::PathFilter::addPath(std::string_view path)
+{
+    std::vector<std::string> components;
+    while (!path.empty()) {
+        auto separator = path.find('/');
+        components.emplace_back(path.substr(0, separator));
+        path = separator != std::string_view::npos ? path.substr(separator + 1) : std::string_view();
+    }
+
+    if (!components.empty()) {
+        this->paths.push_back(std::move(components));
+    }
+}
+
+void
+YAML::PathFilter::clear()
+{
+    this->levels.clear();
+    this->emitSpaces = -1;
+    this->skipSpaces = -1;
+}
+
+void
+YAML::PathFilter::newMapItem(std::string_view name, int spaces)
+{
+    while (!this->levels.empty() && this->levels.back().spaces >= spaces) {
+        this->levels.pop_back();
+    }
+
+    if (this->emitSpaces >= 0 && spaces <= this->emitSpaces) {
+        this->emitSpaces = -1;
+    }
+
+    if (this->emitSpaces >= 0) {
+        if (this->eventObserver != nullptr) {
+            this->eventObserver->newMapItem(name, spaces);
+        }
+        return;
+    }
+
+    this->levels.push_back({std::string(name), spaces});
+    this->skipSpaces = -1;
+    switch (match()) {
+        case Match::Full:
+            this->emitSpaces = spaces;
+            if (this->eventObserver != nullptr) {
+                this->eventObserver->newMapItem(name, spaces);
+            }
+            break;
+        case Match::Prefix:
+            break;
+        case Match::None:
+            this->skipSpaces = spaces;
+            break;
+    }
+}
+
+void
+YAML::PathFilter::newScalar(std::string_view scalar)
+{
+    if (this->emitSpaces >= 0 && this->eventObserver != nullptr) {
+        this->eventObserver->newScalar(scalar);
+    }
+}
+
+void
+YAML::PathFilter::newSequenceItem(int spaces)
+{
+    // A sequence may share the indentation of the key it belongs to
+    while (!this->levels.empty() && this->levels.back().spaces > spaces) {
+        this->levels.pop_back();
+    }
+
+    if (this->emitSpaces >= 0 && spaces < this->emitSpaces) {
+        this->emitSpaces = -1;
+    }
+
+    // An item indented less than the unmatched key ends its subtree
+    if (this->skipSpaces > spaces) {
+        this->skipSpaces = -1;
+    }
+
+    if (this->emitSpaces >= 0 && this->eventObserver != nullptr) {
+        this->eventObserver->newSequenceItem(spaces);
+    }
+}
+
+int
+YAML::PathFilter::getSkipSpaces() const
+{
+    return this->emitSpaces < 0 ? this->skipSpaces : -1;
+}
+
+YAML::PathFilter::Match
+YAML::PathFilter::match() const
+{
+    Match result = Match::None;
+    for (const auto& path : this->paths) {
+        if (path.size() < this->levels.size()) {
+            continue;
+        }
+
+        size_t i = 0;
+        while (i < this->levels.size() && path[i] == this->levels[i].key) {
+            ++i;
+        }
+
+        if (i == this->levels.size()) {
+            if (i == path.size()) {
+                return Match::Full;
+            }
+
+            result = Match::Prefix;
+        }
+    }
+
+    return result;
+}
+
+YAML::SelectiveParser::SelectiveParser(AbstractEventViewObserver *eventObserver)
+    : filter(eventObserver),
+      stateMachine(&filter)
+{
+}
+
+void
+YAML::SelectiveParser::addPath(std::string_view path)
+{
+    this->filter.addPath(path);
+}
+
+bool
+YAML::SelectiveParser::parse(const char *data, size_t length)
+{
+    this->stateMachine.reset();
+    this->filter.clear();
+    this->skippedLines = 0;
+
+    const char *end = data + length;
+    while (data != end) {
+        const char *lineEnd = static_cast<const char *>(std::memchr(data, '\n', end - data));
+        if (lineEnd == nullptr) {
+            lineEnd = end;
+        }
+
+        int skipSpaces = this->filter.getSkipSpaces();
+        bool skip = false;
+        if (skipSpaces >= 0 && this->stateMachine.isIdle()) {
+            // Blank lines are skipped as well; they never produce events
+            const char *position = data;
+            while (position != lineEnd && InputBuffer::isSpace(*position)) {
+                ++position;
+            }
+
+            skip = position == lineEnd || (position - data > skipSpaces && !mayContinue(position, lineEnd));
+        }
+
+        if (skip) {
+            ++this->skippedLines;
+        } else if (!parseLine(data, lineEnd - data)) {
+            return false;
+        }
+
+        data = lineEnd != end ? lineEnd + 1 : end;
+    }
+
+    return this->stateMachine.finish();
+}
+
+bool
+YAML::SelectiveParser::parseFile(const std::string& path)
+{
+    MappedFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+
+    return parse(file.getData(), file.getSize());
+}
+
+size_t
+YAML::SelectiveParser::getSkippedLines() const
+{
+    return this->skippedLines;
+}
+
+bool
+YAML::SelectiveParser::parseLine(const char *data, size_t length)
+{
+    InputBuffer input(data, length);
+    return this->stateMachine.parse(input);
+}
@@ -0,0 +1,292 @@
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define YAML_STRUCTURAL_INDEX_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#include "StructuralIndex.h"
+
+namespace {
+
+using Block = YAML::StructuralIndex::Block;
+using Classifier = void (*)(const char *data, size_t count, Block *blocks);
+
+constexpr size_t BlockSize = YAML::StructuralIndex::BlockSize;
+
+void
+classifyScalar(const char *data, size_t count, Block *blocks)
+{
+    for (size_t i = 0; i < count; ++i, data += BlockSize) {
+        Block block = {};
+        for (size_t j = 0; j < BlockSize; ++j) {
+            unsigned char symbol = static_cast<unsigned char>(data[j]);
+            uint64_t bit = uint64_t(1) << j;
+            if (symbol == ' ' || (symbol >= '\t' && symbol <= '\r')) {
+                block.whitespace |= bit;
+            }
+
+            if (symbol == ':') {
+                block.colon |= bit;
+            } else if (symbol == '#' || symbol == '\r') {
+                block.commentEnd |= bit;
+            } else if (symbol == '\n') {
+                block.newline |= bit;
+            }
+        }
+
+        blocks[i] = block;
+    }
+}
+
+#ifdef YAML_STRUCTURAL_INDEX_X86
+
+#if defined(__GNUC__) || defined(__clang__)
+#define YAML_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define YAML_TARGET_AVX2
+#endif
+
+void
+classifySSE2(const char *data, size_t count, Block *blocks)
+{
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i controlRange = _mm_set1_epi8('\r' - '\t');
+    const __m128i colon = _mm_set1_epi8(':');
+    const __m128i hash = _mm_set1_epi8('#');
+    const __m128i carriageReturn = _mm_set1_epi8('\r');
+    const __m128i newline = _mm_set1_epi8('\n');
+
+    for (size_t i = 0; i < count; ++i, data += BlockSize) {
+        Block block = {};
+        for (size_t j = 0; j < BlockSize; j += 16) {
+            __m128i symbols = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + j));
+
+            // '\t'..'\r' is a contiguous range: (symbol - '\t') <= 4 unsigned
+            __m128i offset = _mm_sub_epi8(symbols, tab);
+            __m128i isControl = _mm_cmpeq_epi8(_mm_min_epu8(offset, controlRange), offset);
+            __m128i isWhitespace = _mm_or_si128(isControl, _mm_cmpeq_epi8(symbols, space));
+            __m128i isCommentEnd = _mm_or_si128(_mm_cmpeq_epi8(symbols, hash),
+                    _mm_cmpeq_epi8(symbols, carriageReturn));
+
+            block.whitespace |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(isWhitespace))) << j;
+            block.colon |= uint64_t(static_cast<uint16_t>(
+                        _mm_movemask_epi8(_mm_cmpeq_epi8(symbols, colon)))) << j;
+            block.commentEnd |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(isCommentEnd))) << j;
+            block.newline |= uint64_t(static_cast<uint16_t>(
+                        _mm_movemask_epi8(_mm_cmpeq_epi8(symbols, newline)))) << j;
+        }
+
+        blocks[i] = block;
+    }
+}
+
+YAML_TARGET_AVX2 void
+classifyAVX2(const char *data, size_t count, Block *blocks)
+{
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i controlRange = _mm256_set1_epi8('\r' - '\t');
+    const __m256i colon = _mm256_set1_epi8(':');
+    const __m256i hash = _mm256_set1_epi8('#');
+    const __m256i carriageReturn = _mm256_set1_epi8('\r');
+    const __m256i newline = _mm256_set1_epi8('\n');
+
+    for (size_t i = 0; i < count; ++i, data += BlockSize) {
+        Block block = {};
+        for (size_t j = 0; j < BlockSize; j += 32) {
+            __m256i symbols = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + j));
+
+            __m256i offset = _mm256_sub_epi8(symbols, tab);
+            __m256i isControl = _mm256_cmpeq_epi8(_mm256_min_epu8(offset, controlRange), offset);
+            __m256i isWhitespace = _mm256_or_si256(isControl, _mm256_cmpeq_epi8(symbols, space));
+            __m256i isCommentEnd = _mm256_or_si256(_mm256_cmpeq_epi8(symbols, hash),
+                    _mm256_cmpeq_epi8(symbols, carriageReturn));
+
+            block.whitespace |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(isWhitespace))) << j;
+            block.colon |= uint64_t(static_cast<uint32_t>(
+                        _mm256_movemask_epi8(_mm256_cmpeq_epi8(symbols, colon)))) << j;
+            block.commentEnd |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(isCommentEnd))) << j;
+            block.newline |= uint64_t(static_cast<uint32_t>(
+                        _mm256_movemask_epi8(_mm256_cmpeq_epi8(symbols, newline)))) << j;
+        }
+
+        blocks[i] = block;
+    }
+}
+
+bool
+cpuSupportsAVX2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+
+    __cpuid(info, 1);
+    bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+    __cpuidex(info, 7, 0);
+    return osSavesYmm && (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#endif
+
+Classifier
+getClassifier(YAML::StructuralIndex::Implementation implementation)
+{
+    switch (implementation) {
+#ifdef YAML_STRUCTURAL_INDEX_X86
+        case YAML::StructuralIndex::Implementation::AVX2:
+            return classifyAVX2;
+        case YAML::StructuralIndex::Implementation::SSE2:
+            return classifySSE2;
+#endif
+        default:
+            return classifyScalar;
+    }
+}
+
+int
+countTrailingZeros(uint64_t value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index = 0;
+    _BitScanForward64(&index, value);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(value);
+#endif
+}
+
+uint64_t
+selectMask(const Block& block, unsigned mask)
+{
+    uint64_t result = 0;
+    if (mask & YAML::StructuralIndex::Whitespace) {
+        result |= block.whitespace;
+    }
+
+    if (mask & YAML::StructuralIndex::Colon) {
+        result |= block.colon;
+    }
+
+    if (mask & YAML::StructuralIndex::CommentEnd) {
+        result |= block.commentEnd;
+    }
+
+    if (mask & YAML::StructuralIndex::Newline) {
+        result |= block.newline;
+    }
+
+    return result;
+}
+
+}
+
+YAML::StructuralIndex::Implementation
+YAML::StructuralIndex::getBestImplementation()
+{
+    static const Implementation implementation =
+        isSupported(Implementation::AVX2) ? Implementation::AVX2 :
+        isSupported(Implementation::SSE2) ? Implementation::SSE2 :
+        Implementation::Scalar;
+    return implementation;
+}
+
+bool
+YAML::StructuralIndex::isSupported(Implementation implementation)
+{
+    switch (implementation) {
+#ifdef YAML_STRUCTURAL_INDEX_X86
+        case Implementation::AVX2:
+            return cpuSupportsAVX2();
+        case Implementation::SSE2:
+            return true;
+#endif
+        case Implementation::Scalar:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void
+YAML::StructuralIndex::build(const char *begin, const char *end)
+{
+    build(begin, end, getBestImplementation());
+}
+
+void
+YAML::StructuralIndex::build(const char *begin, const char *end, Implementation implementation)
+{
+    this->begin = begin;
+    this->end = end;
+
+    size_t length = static_cast<size_t>(end - begin);
+    size_t fullBlocks = length / BlockSize;
+    size_t tail = length % BlockSize;
+    this->blocks.resize(fullBlocks + (tail != 0 ? 1 : 0));
+
+    Classifier classify = getClassifier(implementation);
+    classify(begin, fullBlocks, this->blocks.data());
+
+    if (tail != 0) {
+        // Zero padding classifies as nothing, so the tail block has no
+        // bits set past the end of the input.
+        char padded[BlockSize] = {};
+        std::memcpy(padded, begin + fullBlocks * BlockSize, tail);
+        classify(padded, 1, this->blocks.data() + fullBlocks);
+    }
+}
+
+const char *
+YAML::StructuralIndex::getBegin() const
+{
+    return this->begin;
+}
+
+const char *
+YAML::StructuralIndex::getEnd() const
+{
+    return this->end;
+}
+
+bool
+YAML::StructuralIndex::contains(const char *begin, const char *end) const
+{
+    return this->begin != nullptr && begin >= this->begin && end <= this->end;
+}
+
+const char *
+YAML::StructuralIndex::find(const char *position, const char *limit, unsigned mask) const
+{
+    if (position >= limit) {
+        return limit;
+    }
+
+    size_t offset = static_cast<size_t>(position - this->begin);
+    size_t blockIndex = offset / BlockSize;
+    size_t lastBlock = static_cast<size_t>(limit - this->begin - 1) / BlockSize;
+
+    uint64_t bits = selectMask(this->blocks[blockIndex], mask) & (~uint64_t(0) << (offset % BlockSize));
+    while (bits == 0) {
+        if (++blockIndex > lastBlock) {
+            return limit;
+        }
+
+        bits = selectMask(this->blocks[blockIndex], mask);
+    }
+
+    const char *result = this->begin + blockIndex * BlockSize + countTrailingZeros(bits);
+    return result < limit ? result : limit;
+}
@@ -0,0 +1,30 @@
+#include "TypedScalarAdapter.h"
+
+YAML::TypedScalarAdapter::TypedScalarAdapter(AbstractTypedEventObserver *eventObserver)
+    : eventObserver(eventObserver)
+{
+}
+
+void
+YAML::TypedScalarAdapter::newMapItem(std::string_view name, int spaces)
+{
+    if (this->eventObserver != nullptr) {
+        this->eventObserver->newMapItem(name, spaces);
+    }
+}
+
+void
+YAML::TypedScalarAdapter::newScalar(std::string_view scalar)
+{
+    if (this->eventObserver != nullptr) {
+        this->eventObserver->newScalar(ScalarValue::classify(scalar));
+    }
+}
+
+void
+YAML::TypedScalarAdapter::newSequenceItem(int spaces)
+{
+    if (this->eventObserver != nullptr) {
+        this->eventObserver->newSequenceItem(spaces);
+    }
+}
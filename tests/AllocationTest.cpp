@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include "LineParser.h"
+#include "Parser.h"
+#include "FakeEventViewObserver.h"
+
+namespace {
+
+std::atomic<size_t> allocations(0);
+
+// All replaced forms go through these two, so every pointer is released by
+// the function that matches its allocation
+void *
+allocate(size_t size)
+{
+    ++allocations;
+    if (void *pointer = std::malloc(size != 0 ? size : 1)) {
+        return pointer;
+    }
+
+    throw std::bad_alloc();
+}
+
+void
+release(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+class CountingObserver : public YAML::AbstractEventViewObserver {
+public:
+    void newMapItem(std::string_view, int) override {
+        ++this->events;
+    }
+
+    void newScalar(std::string_view) override {
+        ++this->events;
+    }
+
+    void newSequenceItem(int) override {
+        ++this->events;
+    }
+public:
+    size_t events = 0;
+};
+
+}
+
+void *
+operator new(size_t size)
+{
+    return allocate(size);
+}
+
+void *
+operator new[](size_t size)
+{
+    return allocate(size);
+}
+
+void
+operator delete(void *pointer) noexcept
+{
+    release(pointer);
+}
+
+void
+operator delete[](void *pointer) noexcept
+{
+    release(pointer);
+}
+
+void
+operator delete(void *pointer, size_t) noexcept
+{
+    release(pointer);
+}
+
+void
+operator delete[](void *pointer, size_t) noexcept
+{
+    release(pointer);
+}
+
+TEST(YamlAllocation, parserResetTest)
+{
+    const std::string inputs[] = {
+        "hr: 65\navg: 0.278\nrbi: 147\n",
+        "- item : Super Hoop\n  quantity: 1\n- item : Basketball\n  quantity: 4",
+        "- a b: c\nhr: 65\n",
+        "bill-to:\n    given : Chris\n# comment\n",
+        "script: |-\n    echo a\n\n    echo b\nnext: >\n  folded\n  text\n",
+        "flow: {a: [1, 2], b: c}\nmulti: [x,\n  y]\n",
+    };
+
+    CountingObserver observer;
+    YAML::Parser parser(&observer);
+    for (const auto& input : inputs) {
+        parser.reset();
+        parser.parse(input.data(), input.size());
+        parser.reset();
+        parser.feed(input.data(), input.size() / 2);
+        parser.feed(input.data() + input.size() / 2, input.size() - input.size() / 2);
+        parser.finish();
+    }
+
+    size_t events = observer.events;
+    size_t before = allocations;
+    ASSERT_NE(0, before);
+    for (int i = 0; i < 1000; ++i) {
+        for (const auto& input : inputs) {
+            parser.reset();
+            parser.parse(input.data(), input.size());
+            parser.reset();
+            parser.feed(input.data(), input.size() / 2);
+            parser.feed(input.data() + input.size() / 2, input.size() - input.size() / 2);
+            parser.finish();
+        }
+    }
+
+    ASSERT_EQ(before, allocations);
+    ASSERT_EQ(events * 1001, observer.events);
+}
+
+TEST(YamlAllocation, lineParserResetTest)
+{
+    const std::string input("- item : Super Hoop");
+
+    CountingObserver observer;
+    YAML::LineParser lineParser(&observer);
+    ASSERT_TRUE(lineParser.parse(input.data(), input.size()));
+
+    size_t before = allocations;
+    for (int i = 0; i < 1000; ++i) {
+        lineParser.reset();
+        ASSERT_TRUE(lineParser.parse(input.data(), input.size()));
+    }
+
+    ASSERT_EQ(before, allocations);
+}
+
+TEST(YamlAllocation, resetRestoresInitialStateTest)
+{
+    Fake::EventViewObserver observer;
+    YAML::Parser parser(&observer);
+
+    ASSERT_FALSE(parser.parse("- a b: c\n", 9));
+    parser.reset();
+    ASSERT_TRUE(parser.isIdle());
+    ASSERT_TRUE(parser.feed("key:", 4));
+    parser.reset();
+
+    observer.events.clear();
+    ASSERT_TRUE(parser.parse("hr: 65", 6));
+    ASSERT_EQ(2, observer.events.size());
+    ASSERT_EQ("65", observer.events[1].getValue());
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <string>
+
+#include "AsyncFileParser.h"
+#include "Parser.h"
+#include "FakeEventViewObserver.h"
+
+namespace {
+
+void
+assertSameEvents(const Fake::EventViewObserver& expected, const Fake::EventViewObserver& observer)
+{
+    ASSERT_EQ(expected.events.size(), observer.events.size());
+    for (size_t i = 0; i < expected.events.size(); ++i) {
+        ASSERT_EQ(expected.events[i].getType(), observer.events[i].getType());
+        ASSERT_EQ(expected.events[i].getValue(), observer.events[i].getValue());
+        ASSERT_EQ(expected.events[i].getSpaces(), observer.events[i].getSpaces());
+    }
+}
+
+}
+
+TEST(YamlAsyncFileParser, blockBoundariesTest)
+{
+    const std::string path = testing::TempDir() + "async-file-parser.yml";
+    {
+        std::ofstream file(path, std::ios::binary);
+        for (int i = 0; i < 500; ++i) {
+            file << "- item : Super Hoop " << i << "\n"
+                 << "  quantity: " << i << "\r\n";
+        }
+    }
+
+    Fake::EventViewObserver expected;
+    YAML::Parser parser(&expected);
+    ASSERT_TRUE(parser.parseFile(path));
+
+    for (size_t blockSize : {size_t(1), size_t(7), size_t(4096), YAML::AsyncFileParser::DefaultBlockSize}) {
+        Fake::EventViewObserver observer;
+        YAML::AsyncFileParser asyncParser(&observer, blockSize, 3);
+        ASSERT_TRUE(asyncParser.parseFile(path));
+        assertSameEvents(expected, observer);
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST(YamlAsyncFileParser, failureTest)
+{
+    const std::string path = TEST_DATA_DIR "/invoice.yml";
+
+    Fake::EventViewObserver expected;
+    YAML::Parser parser(&expected);
+    ASSERT_FALSE(parser.parseFile(path));
+
+    Fake::EventViewObserver observer;
+    YAML::AsyncFileParser asyncParser(&observer, 100);
+    ASSERT_FALSE(asyncParser.parseFile(path));
+    assertSameEvents(expected, observer);
+    ASSERT_EQ(parser.getError().line, asyncParser.getError().line);
+    ASSERT_EQ(parser.getError().offset, asyncParser.getError().offset);
+
+    ASSERT_FALSE(asyncParser.parseFile(TEST_DATA_DIR "/missing.yml"));
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "BatchLoader.h"
+
+TEST(YamlBatchLoader, loadBuffersTest)
+{
+    std::vector<std::string> inputs;
+    for (int i = 0; i < 200; ++i) {
+        inputs.push_back(i % 7 == 3 ? "- a b: c\n" : "id: " + std::to_string(i) + "\nname: service\n");
+    }
+
+    std::vector<std::string_view> buffers(inputs.begin(), inputs.end());
+    for (unsigned threads : {1u, 4u}) {
+        YAML::BatchLoader loader(threads);
+        auto results = loader.loadBuffers(buffers);
+
+        ASSERT_EQ(inputs.size(), results.size());
+        for (size_t i = 0; i < results.size(); ++i) {
+            if (i % 7 == 3) {
+                ASSERT_EQ(YAML::BatchLoader::Status::ParseFailed, results[i].status);
+                ASSERT_EQ(1, results[i].error.line);
+                ASSERT_EQ(3, results[i].error.column);
+            } else {
+                ASSERT_EQ(YAML::BatchLoader::Status::Ok, results[i].status);
+                ASSERT_EQ(std::to_string(i), results[i].document.find("id")->getValue());
+            }
+        }
+    }
+}
+
+TEST(YamlBatchLoader, loadFilesTest)
+{
+    const std::vector<std::string> paths = {
+        TEST_DATA_DIR "/invoice.yml",
+        TEST_DATA_DIR "/missing.yml",
+        TEST_DATA_DIR "/win.yml",
+    };
+
+    YAML::BatchLoader loader(2);
+    auto results = loader.loadFiles(paths);
+
+    ASSERT_EQ(3, results.size());
+    ASSERT_EQ(YAML::BatchLoader::Status::ParseFailed, results[0].status);
+    ASSERT_EQ(1, results[0].error.line);
+    ASSERT_EQ(YAML::BatchLoader::Status::OpenFailed, results[1].status);
+    ASSERT_EQ(YAML::BatchLoader::Status::Ok, results[2].status);
+    ASSERT_EQ("Windows.", results[2].document.find("name")->getValue());
+}
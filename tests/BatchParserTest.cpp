@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "BatchParser.h"
+#include "Parser.h"
+#include "FakeEventViewObserver.h"
+
+namespace {
+
+// Replays batches into a Fake::EventViewObserver so they can be compared
+// with the events Parser delivers
+class BatchCollector : public YAML::AbstractEventBatchObserver {
+public:
+    void newEvents(const char *base, const YAML::EventRecord *records, size_t count) override {
+        this->batches.push_back(count);
+        for (size_t i = 0; i < count; ++i) {
+            std::string_view text(base + records[i].offset, records[i].length);
+            switch (records[i].kind) {
+                case YAML::EventRecord::Kind::MapItem:
+                    this->observer.newMapItem(text, records[i].spaces);
+                    break;
+                case YAML::EventRecord::Kind::Scalar:
+                    this->observer.newScalar(text);
+                    break;
+                case YAML::EventRecord::Kind::SequenceItem:
+                    this->observer.newSequenceItem(records[i].spaces);
+                    break;
+            }
+        }
+    }
+public:
+    Fake::EventViewObserver observer;
+    std::vector<size_t> batches;
+};
+
+void
+assertSameEvents(const Fake::EventViewObserver& expected, const Fake::EventViewObserver& observer)
+{
+    ASSERT_EQ(expected.events.size(), observer.events.size());
+    for (size_t i = 0; i < expected.events.size(); ++i) {
+        ASSERT_EQ(expected.events[i].getType(), observer.events[i].getType());
+        ASSERT_EQ(expected.events[i].getData(), observer.events[i].getData());
+        ASSERT_EQ(expected.events[i].getValue(), observer.events[i].getValue());
+        ASSERT_EQ(expected.events[i].getSpaces(), observer.events[i].getSpaces());
+    }
+}
+
+}
+
+TEST(YamlBatchParser, batchSizeTest)
+{
+    const std::string input("# Products purchased\n"
+                            "- item : Super Hoop\n"
+                            "  quantity: 1\n"
+                            "- item : Basketball\n"
+                            "  quantity: 4\n"
+                            "-\n"
+                            "   name: Mark McGwire");
+
+    Fake::EventViewObserver expected;
+    YAML::Parser parser(&expected);
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+
+    for (size_t batchSize : {size_t(1), size_t(4), YAML::BatchParser::DefaultBatchSize}) {
+        BatchCollector collector;
+        YAML::BatchParser batchParser(&collector, batchSize);
+        ASSERT_TRUE(batchParser.parse(input.data(), input.size()));
+
+        assertSameEvents(expected, collector.observer);
+        for (size_t i = 0; i + 1 < collector.batches.size(); ++i) {
+            ASSERT_EQ(batchSize, collector.batches[i]);
+        }
+    }
+}
+
+TEST(YamlBatchParser, errorFlushesEventsTest)
+{
+    const std::string input("hr: 65\n"
+                            "- a b: c\n"
+                            "avg: 0.278\n");
+
+    BatchCollector collector;
+    YAML::BatchParser batchParser(&collector);
+    ASSERT_FALSE(batchParser.parse(input.data(), input.size()));
+    ASSERT_EQ(1, collector.batches.size());
+    ASSERT_EQ("65", collector.observer.events[1].getValue());
+}
+
+TEST(YamlBatchParser, blockScalarTest)
+{
+    const std::string input("hr: 65\n"
+                            "script: |\n"
+                            "  echo a\n"
+                            "  echo b\n"
+                            "avg: 0.278\n");
+
+    BatchCollector collector;
+    YAML::BatchParser batchParser(&collector);
+    ASSERT_TRUE(batchParser.parse(input.data(), input.size()));
+
+    // The joined value is delivered between the batches around it
+    ASSERT_EQ(3, collector.batches.size());
+    ASSERT_EQ(1, collector.batches[1]);
+    ASSERT_EQ(6, collector.observer.events.size());
+    ASSERT_EQ("echo a\necho b\n", collector.observer.events[3].getValue());
+    ASSERT_EQ("0.278", collector.observer.events[5].getValue());
+}
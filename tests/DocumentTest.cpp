@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+#include "Arena.h"
+#include "Document.h"
+#include "DocumentBuilder.h"
+#include "Parser.h"
+
+TEST(YamlArena, allocateAlignedTest)
+{
+    YAML::Arena arena(128);
+
+    for (int i = 0; i < 100; ++i) {
+        arena.allocate(3, 1);
+        auto pointer = reinterpret_cast<uintptr_t>(arena.allocate(sizeof(double), alignof(double)));
+        ASSERT_EQ(0, pointer % alignof(double));
+    }
+
+    void *large = arena.allocate(1000);
+    ASSERT_NE(nullptr, large);
+
+    ASSERT_EQ("copied", arena.copy("copied"));
+    arena.clear();
+    ASSERT_EQ(0, arena.getAllocatedSize());
+}
+
+TEST(YamlDocument, compactSequenceOfMappingTest)
+{
+    const std::string input("# Products purchased\r\n"
+                            "- item : Super Hoop\r\n"
+                            "  quantity: 1\r\n"
+                            "- item : Basketball\r\n"
+                            "  quantity: 4\r\n"
+                            "- item : Big Shoes\r\n"
+                            "  quantity: 1");
+
+    YAML::Document document;
+    YAML::DocumentBuilder builder(document);
+    YAML::Parser parser(&builder);
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+
+    const YAML::Node *root = document.getRoot();
+    ASSERT_TRUE(root->isSequence());
+    ASSERT_EQ(3, root->size());
+
+    const YAML::Node *item = root->at(1);
+    ASSERT_TRUE(item->isMap());
+    ASSERT_EQ(2, item->size());
+    ASSERT_EQ("Basketball", item->find("item")->getValue());
+    ASSERT_EQ("4", item->find("quantity")->getValue());
+    ASSERT_EQ(nullptr, item->find("price"));
+
+    ASSERT_EQ("Big Shoes", root->at(2)->find("item")->getValue());
+    ASSERT_EQ(nullptr, root->at(3));
+}
+
+TEST(YamlDocument, sequenceOfMappingTest)
+{
+    std::stringstream input("-\n"
+                            "   name: Mark McGwire\n"
+                            "   hr: 65\n"
+                            "-\n"
+                            "   name: Sammy Sosa\n"
+                            "   hr: 63\n");
+
+    YAML::Document document;
+    YAML::DocumentBuilder builder(document);
+    YAML::Parser parser(&builder);
+    ASSERT_TRUE(parser.parse(input));
+
+    const YAML::Node *root = document.getRoot();
+    ASSERT_EQ(2, root->size());
+    ASSERT_EQ("Mark McGwire", root->at(0)->find("name")->getValue());
+    ASSERT_EQ("65", root->at(0)->find("hr")->getValue());
+    ASSERT_EQ("Sammy Sosa", root->at(1)->find("name")->getValue());
+    ASSERT_EQ("63", root->at(1)->find("hr")->getValue());
+}
+
+TEST(YamlDocument, nestedEventsTest)
+{
+    YAML::Document document;
+    YAML::DocumentBuilder builder(document);
+
+    builder.newMapItem("invoice", 0);
+    builder.newScalar("34843");
+    builder.newMapItem("bill-to", 0);
+    builder.newMapItem("given", 4);
+    builder.newScalar("Chris");
+    builder.newMapItem("address", 4);
+    builder.newMapItem("city", 8);
+    builder.newScalar("Royal Oak");
+    builder.newMapItem("family", 4);
+    builder.newScalar("Dumars");
+    builder.newMapItem("product", 0);
+    builder.newSequenceItem(0);
+    builder.newScalar("first");
+    builder.newSequenceItem(0);
+    builder.newScalar("second");
+    builder.newMapItem("total", 0);
+    builder.newScalar("4443.52");
+
+    ASSERT_EQ("34843", document.find("invoice")->getValue());
+    ASSERT_EQ("Royal Oak", document.find("bill-to/address/city")->getValue());
+    ASSERT_EQ("Dumars", document.find("bill-to/family")->getValue());
+    ASSERT_EQ(3, document.find("bill-to")->size());
+    ASSERT_TRUE(document.find("product")->isSequence());
+    ASSERT_EQ("second", document.find("product")->at(1)->getValue());
+    ASSERT_EQ("4443.52", document.find("total")->getValue());
+    ASSERT_EQ(nullptr, document.find("bill-to/missing"));
+}
+
+TEST(YamlDocument, bareKeyParentTest)
+{
+    const std::string input("bill-to:\n"
+                            "    given: Chris\n"
+                            "    family: Dumars\n"
+                            "    address:\n"
+                            "        lines: 458 Walkman Dr.\n"
+                            "        city : Royal Oak\n"
+                            "stats: batting\n"
+                            "    avg: 0.278\n"
+                            "nested:\n"
+                            "    z:\n"
+                            "    w: 3\n"
+                            "tax: 1\n");
+
+    for (auto strings : {YAML::DocumentBuilder::Strings::Copy, YAML::DocumentBuilder::Strings::Reference}) {
+        YAML::Document document;
+        YAML::DocumentBuilder builder(document, strings);
+        YAML::Parser parser(&builder);
+        ASSERT_TRUE(parser.parse(input.data(), input.size()));
+
+        // The line after a bare key arrives as its scalar and becomes the
+        // first entry
+        const YAML::Node *billTo = document.find("bill-to");
+        ASSERT_TRUE(billTo->isMap());
+        ASSERT_EQ(3, billTo->size());
+        ASSERT_EQ("Chris", document.find("bill-to/given")->getValue());
+        ASSERT_EQ("Dumars", document.find("bill-to/family")->getValue());
+        ASSERT_EQ("458 Walkman Dr.", document.find("bill-to/address/lines")->getValue());
+        ASSERT_EQ("Royal Oak", document.find("bill-to/address/city")->getValue());
+
+        // A scalar on the key line is kept with the container
+        ASSERT_TRUE(document.find("stats")->isMap());
+        ASSERT_EQ("batting", document.find("stats")->getValue());
+        ASSERT_EQ("0.278", document.find("stats/avg")->getValue());
+        ASSERT_TRUE(document.find("nested/z")->isNull());
+        ASSERT_EQ("3", document.find("nested/w")->getValue());
+        ASSERT_EQ("1", document.find("tax")->getValue());
+    }
+}
+
+TEST(YamlDocument, referencedStringsTest)
+{
+    const std::string input("hr: 65\n"
+                            "avg: 0.278\n");
+
+    YAML::Document document;
+    YAML::DocumentBuilder builder(document, YAML::DocumentBuilder::Strings::Reference);
+    YAML::Parser parser(&builder);
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+
+    ASSERT_EQ(input.data() + 4, document.find("hr")->getValue().data());
+    ASSERT_EQ("0.278", document.find("avg")->getValue());
+
+    document.clear();
+    ASSERT_TRUE(document.getRoot()->isNull());
+}
+
+TEST(YamlDocument, flowCollectionTest)
+{
+    const std::string input("name: {first: Mark, last: McGwire}\n"
+                            "hr: [65, 70]\n"
+                            "teams: [{city: Boston}, [a, b]]\n");
+
+    YAML::Document document;
+    YAML::DocumentBuilder builder(document);
+    YAML::Parser parser(&builder);
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+
+    ASSERT_EQ("McGwire", document.find("name/last")->getValue());
+    ASSERT_EQ(2, document.find("hr")->size());
+    ASSERT_EQ("70", document.find("hr")->at(1)->getValue());
+    ASSERT_EQ("Boston", document.find("teams")->at(0)->find("city")->getValue());
+    ASSERT_EQ("b", document.find("teams")->at(1)->at(1)->getValue());
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "EventCache.h"
+#include "DocumentBuilder.h"
+#include "Parser.h"
+#include "FakeEventViewObserver.h"
+
+namespace {
+
+const std::string input("- name: Mark McGwire\n"
+                        "  hr:   65\n"
+                        "  avg:  0.278\n"
+                        "- name: Sammy Sosa\n"
+                        "  hr:   63\n"
+                        "  avg:  0.288\n");
+
+}
+
+TEST(YamlEventCache, replayTest)
+{
+    const std::string path = testing::TempDir() + "event-cache-replay.bin";
+    ASSERT_TRUE(YAML::EventCacheWriter::write(input.data(), input.size(), path));
+
+    Fake::EventViewObserver expected;
+    YAML::Parser parser(&expected);
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+
+    YAML::EventCache cache(path);
+    ASSERT_TRUE(cache.isOpen());
+    ASSERT_TRUE(cache.matches(input.data(), input.size()));
+    ASSERT_FALSE(cache.matches(input.data(), input.size() - 1));
+    ASSERT_EQ(expected.events.size(), cache.getEventCount());
+
+    Fake::EventViewObserver observer;
+    cache.replay(&observer);
+
+    ASSERT_EQ(expected.events.size(), observer.events.size());
+    for (size_t i = 0; i < expected.events.size(); ++i) {
+        ASSERT_EQ(expected.events[i].getType(), observer.events[i].getType());
+        ASSERT_EQ(expected.events[i].getValue(), observer.events[i].getValue());
+        ASSERT_EQ(expected.events[i].getSpaces(), observer.events[i].getSpaces());
+    }
+}
+
+TEST(YamlEventCache, documentTest)
+{
+    const std::string path = testing::TempDir() + "event-cache-document.bin";
+    ASSERT_TRUE(YAML::EventCacheWriter::write(input.data(), input.size(), path));
+
+    YAML::EventCache cache(path);
+    ASSERT_TRUE(cache.isOpen());
+
+    // Strings of the tree point into the mapped cache
+    YAML::Document document;
+    YAML::DocumentBuilder builder(document, YAML::DocumentBuilder::Strings::Reference);
+    cache.replay(&builder);
+
+    const YAML::Node *root = document.getRoot();
+    ASSERT_NE(nullptr, root);
+    ASSERT_EQ(2, root->size());
+    ASSERT_EQ("Sammy Sosa", root->at(1)->find("name")->getValue());
+    ASSERT_EQ("0.278", root->at(0)->find("avg")->getValue());
+}
+
+TEST(YamlEventCache, invalidFileTest)
+{
+    const std::string path = testing::TempDir() + "event-cache-invalid.bin";
+
+    // Nothing is written for input that does not parse
+    std::remove(path.c_str());
+    const std::string invalid("key: value\n-x\n");
+    ASSERT_FALSE(YAML::EventCacheWriter::write(invalid.data(), invalid.size(), path));
+    ASSERT_FALSE(YAML::EventCache(path).isOpen());
+
+    ASSERT_TRUE(YAML::EventCacheWriter::write(input.data(), input.size(), path));
+
+    std::string data;
+    {
+        std::ifstream file(path, std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    // Truncated text
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), data.size() - 1);
+    }
+    ASSERT_FALSE(YAML::EventCache(path).isOpen());
+
+    // A record pointing past the text
+    std::string corrupted = data;
+    corrupted[sizeof(YAML::EventCacheHeader)] = '\x7f';
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << corrupted;
+    }
+    ASSERT_FALSE(YAML::EventCache(path).isOpen());
+
+    // Wrong magic
+    corrupted = data;
+    corrupted[0] = 'X';
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << corrupted;
+    }
+    ASSERT_FALSE(YAML::EventCache(path).isOpen());
+
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << data;
+    }
+    ASSERT_TRUE(YAML::EventCache(path).isOpen());
+}
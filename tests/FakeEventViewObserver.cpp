@@ -0,0 +1,51 @@
+#include "FakeEventViewObserver.h"
+
+Fake::EventViewObserver::Event::Event(Type type, std::string_view value, int spaces)
+    : type(type),
+      value(value),
+      data(value.data()),
+      spaces(spaces)
+{
+}
+
+Fake::EventViewObserver::Event::Type
+Fake::EventViewObserver::Event::getType() const
+{
+    return this->type;
+}
+
+const std::string&
+Fake::EventViewObserver::Event::getValue() const
+{
+    return this->value;
+}
+
+const char *
+Fake::EventViewObserver::Event::getData() const
+{
+    return this->data;
+}
+
+int
+Fake::EventViewObserver::Event::getSpaces() const
+{
+    return this->spaces;
+}
+
+void
+Fake::EventViewObserver::newMapItem(std::string_view name, int spaces)
+{
+    this->events.emplace_back(Event::Type::MapItem, name, spaces);
+}
+
+void
+Fake::EventViewObserver::newScalar(std::string_view scalar)
+{
+    this->events.emplace_back(Event::Type::Scalar, scalar, 0);
+}
+
+void
+Fake::EventViewObserver::newSequenceItem(int spaces)
+{
+    this->events.emplace_back(Event::Type::SequenceItem, std::string_view(), spaces);
+}
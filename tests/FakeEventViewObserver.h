@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "AbstractEventViewObserver.h"
+
+namespace Fake {
+
+class EventViewObserver : public YAML::AbstractEventViewObserver {
+public:
+    class Event {
+    public:
+        enum class Type {
+            MapItem,
+            Scalar,
+            SequenceItem,
+        };
+    public:
+        Event(Type type, std::string_view value, int spaces);
+
+        Type getType() const;
+        const std::string& getValue() const;
+        const char *getData() const;
+        int getSpaces() const;
+    private:
+        Type type;
+        std::string value;
+        const char *data;
+        int spaces;
+    };
+public:
+    void newMapItem(std::string_view name, int spaces) override;
+    void newScalar(std::string_view scalar) override;
+    void newSequenceItem(int spaces) override;
+public:
+    std::vector<Event> events;
+};
+
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "FlowTokenizer.h"
+
+namespace {
+
+using Token = YAML::FlowTokenizer::Token;
+
+std::vector<std::pair<Token, std::string>> tokenize(const std::string& input)
+{
+    YAML::FlowTokenizer tokenizer(input.data(), input.data() + input.size());
+    std::vector<std::pair<Token, std::string>> tokens;
+    for (Token token = tokenizer.next(); token != Token::End; token = tokenizer.next()) {
+        tokens.emplace_back(token, token == Token::Scalar ? std::string(tokenizer.getScalar()) : std::string());
+        if (token == Token::Error) {
+            break;
+        }
+    }
+
+    return tokens;
+}
+
+}
+
+TEST(YamlFlowTokenizer, tokensTest)
+{
+    const std::vector<std::pair<Token, std::string>> expected = {
+        {Token::MapBegin, ""},
+        {Token::Scalar, "a b"},
+        {Token::Colon, ""},
+        {Token::SequenceBegin, ""},
+        {Token::Scalar, "http://x"},
+        {Token::Comma, ""},
+        {Token::Scalar, "\"c, d\""},
+        {Token::SequenceEnd, ""},
+        {Token::Comma, ""},
+        {Token::Scalar, "'it''s'"},
+        {Token::Colon, ""},
+        {Token::Scalar, "a#b"},
+        {Token::MapEnd, ""},
+    };
+
+    ASSERT_EQ(expected, tokenize("{ a b : [http://x, \"c, d\"], 'it''s':a#b } # comment"));
+}
+
+TEST(YamlFlowTokenizer, quotedTest)
+{
+    // Escaped quotes do not end a double quoted scalar
+    auto tokens = tokenize("[\"a\\\"b\", 'c']");
+    ASSERT_EQ(5, tokens.size());
+    ASSERT_EQ("\"a\\\"b\"", tokens[1].second);
+    ASSERT_EQ("'c'", tokens[3].second);
+
+    tokens = tokenize("[\"open");
+    ASSERT_EQ(Token::Error, tokens.back().first);
+}
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "IncrementalParser.h"
+
+namespace {
+
+// Applies the reported changes to a copy of the previous events
+class EventReplayer : public YAML::AbstractEventDiffObserver {
+public:
+    EventReplayer(const std::vector<YAML::ParsedEvent>& events)
+        : events(events)
+    {
+    }
+
+    void eventAdded(size_t index, const YAML::ParsedEvent& event) override {
+        ASSERT_LE(index, events.size());
+        events.insert(events.begin() + index, event);
+        ++added;
+    }
+
+    void eventRemoved(size_t index, const YAML::ParsedEvent& event) override {
+        ASSERT_LT(index, events.size());
+        ASSERT_EQ(event, events[index]);
+        events.erase(events.begin() + index);
+        ++removed;
+    }
+
+    void eventChanged(size_t index, const YAML::ParsedEvent& before, const YAML::ParsedEvent& after) override {
+        ASSERT_LT(index, events.size());
+        ASSERT_EQ(before, events[index]);
+        events[index] = after;
+        ++changed;
+    }
+
+    std::vector<YAML::ParsedEvent> events;
+    size_t added = 0;
+    size_t removed = 0;
+    size_t changed = 0;
+};
+
+std::string makeDocument(int entries)
+{
+    std::string input;
+    for (int i = 0; i < entries; ++i) {
+        input += "entry" + std::to_string(i) + ": x\n"
+                 "    name: item" + std::to_string(i) + "\n"
+                 "    tags: list\n"
+                 "        - first\n"
+                 "        - second\n";
+    }
+
+    return input;
+}
+
+}
+
+TEST(YamlIncrementalParser, changeValueTest)
+{
+    std::string input = makeDocument(100);
+
+    YAML::IncrementalParser parser;
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+    ASSERT_EQ(500, parser.getLineCount());
+    ASSERT_EQ(500, parser.getParsedLines());
+
+    size_t offset = input.find("item42");
+    input.replace(offset, 6, "renamed");
+
+    EventReplayer replayer(parser.getEvents());
+    ASSERT_TRUE(parser.update(input.data(), input.size(), offset, 6, 7, &replayer));
+    ASSERT_EQ(1, parser.getParsedLines());
+
+    ASSERT_EQ(0, replayer.added);
+    ASSERT_EQ(0, replayer.removed);
+    ASSERT_EQ(1, replayer.changed);
+    ASSERT_EQ(parser.getEvents(), replayer.events);
+
+    YAML::IncrementalParser full;
+    ASSERT_TRUE(full.parse(input.data(), input.size()));
+    ASSERT_EQ(full.getEvents(), parser.getEvents());
+}
+
+TEST(YamlIncrementalParser, insertLinesTest)
+{
+    std::string input = makeDocument(10);
+
+    YAML::IncrementalParser parser;
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+
+    const std::string lines("        - third\n        - fourth\n");
+    size_t offset = input.find("entry5");
+    input.insert(offset, lines);
+
+    EventReplayer replayer(parser.getEvents());
+    ASSERT_TRUE(parser.update(input.data(), input.size(), offset, 0, lines.size(), &replayer));
+    ASSERT_EQ(3, parser.getParsedLines());
+    ASSERT_EQ(52, parser.getLineCount());
+
+    ASSERT_EQ(4, replayer.added);
+    ASSERT_EQ(0, replayer.removed);
+    ASSERT_EQ(0, replayer.changed);
+    ASSERT_EQ(parser.getEvents(), replayer.events);
+
+    // Removing them again restores the original events
+    input.erase(offset, lines.size());
+    ASSERT_TRUE(parser.update(input.data(), input.size(), offset, lines.size(), 0));
+    ASSERT_EQ(50, parser.getLineCount());
+
+    YAML::IncrementalParser full;
+    ASSERT_TRUE(full.parse(input.data(), input.size()));
+    ASSERT_EQ(full.getEvents(), parser.getEvents());
+}
+
+TEST(YamlIncrementalParser, blockScalarTest)
+{
+    std::string input = makeDocument(5);
+    input.insert(input.find("entry3"), "script: |\n"
+                                       "    echo a\n"
+                                       "    echo b\n"
+                                       "    echo c\n");
+
+    YAML::IncrementalParser parser;
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+
+    // The edited block is parsed from its header to the line after it
+    size_t offset = input.find("echo b");
+    input.replace(offset, 6, "exit 1");
+
+    EventReplayer replayer(parser.getEvents());
+    ASSERT_TRUE(parser.update(input.data(), input.size(), offset, 6, 6, &replayer));
+    ASSERT_EQ(5, parser.getParsedLines());
+    ASSERT_EQ(1, replayer.changed);
+    ASSERT_EQ(parser.getEvents(), replayer.events);
+
+    YAML::IncrementalParser full;
+    ASSERT_TRUE(full.parse(input.data(), input.size()));
+    ASSERT_EQ(full.getEvents(), parser.getEvents());
+
+    const auto& events = parser.getEvents();
+    auto script = std::find_if(events.begin(), events.end(), [](const YAML::ParsedEvent& event) {
+        return event.value == "script";
+    });
+    ASSERT_NE(events.end(), script);
+    ASSERT_EQ("echo a\nexit 1\necho c\n", (script + 1)->value);
+}
+
+TEST(YamlIncrementalParser, randomEditsTest)
+{
+    const std::string fragments[] = {"\n", " ", ":", "- ", "#", "key: value\n", "    - item\n", "x", "", "key: |\n", ">\n",
+                                     "[", "]", "{a: ", "}", ", "};
+
+    std::mt19937 random(20);
+    std::string input = makeDocument(20);
+
+    YAML::IncrementalParser parser;
+    parser.parse(input.data(), input.size());
+
+    for (int i = 0; i < 2000; ++i) {
+        size_t offset = std::uniform_int_distribution<size_t>(0, input.size())(random);
+        size_t removed = std::min<size_t>(input.size() - offset, random() % 8);
+        const std::string& inserted = fragments[random() % std::size(fragments)];
+        input.replace(offset, removed, inserted);
+
+        EventReplayer replayer(parser.getEvents());
+        bool result = parser.update(input.data(), input.size(), offset, removed, inserted.size(), &replayer);
+
+        YAML::IncrementalParser full;
+        ASSERT_EQ(full.parse(input.data(), input.size()), result);
+        ASSERT_EQ(full.getLineCount(), parser.getLineCount());
+        ASSERT_EQ(full.getEvents(), parser.getEvents());
+        ASSERT_EQ(parser.getEvents(), replayer.events);
+
+        // Keep the document mostly valid so most edits take the incremental path
+        if (!result) {
+            input = makeDocument(20);
+            parser.parse(input.data(), input.size());
+        }
+    }
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "KeyInterningAdapter.h"
+#include "KeyTable.h"
+#include "Parser.h"
+
+namespace {
+
+class KeyCollector : public YAML::AbstractKeyEventObserver {
+public:
+    void newMapItem(const YAML::KeyTable::Key& key, int) override {
+        this->keys.push_back(&key);
+        this->names.emplace_back(key.name);
+        this->ids.push_back(key.id);
+    }
+
+    void newScalar(std::string_view scalar) override {
+        this->scalars.emplace_back(scalar);
+    }
+
+    void newSequenceItem(int) override {
+    }
+public:
+    std::vector<const YAML::KeyTable::Key *> keys;
+    std::vector<std::string> names;
+    std::vector<uint32_t> ids;
+    std::vector<std::string> scalars;
+};
+
+}
+
+TEST(YamlKeyTable, internTest)
+{
+    YAML::KeyTable keys;
+    ASSERT_EQ(nullptr, keys.find("time"));
+
+    std::string name("time");
+    const YAML::KeyTable::Key *key = keys.intern(name);
+    name.assign("user");
+
+    ASSERT_EQ("time", key->name);
+    ASSERT_EQ(0, key->id);
+    ASSERT_EQ(YAML::KeyTable::hash("time"), key->hash);
+    ASSERT_EQ(key, keys.intern("time"));
+    ASSERT_EQ(key, keys.find("time"));
+    ASSERT_EQ(key, keys.get(0));
+    ASSERT_EQ(nullptr, keys.get(1));
+
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_EQ(static_cast<uint32_t>(i + 1), keys.intern("key" + std::to_string(i))->id);
+    }
+
+    ASSERT_EQ(10001, keys.size());
+    ASSERT_EQ(key, keys.find("time"));
+    for (uint32_t id = 0; id < keys.size(); ++id) {
+        ASSERT_EQ(id, keys.get(id)->id);
+        ASSERT_EQ(keys.get(id), keys.find(keys.get(id)->name));
+    }
+}
+
+TEST(YamlKeyTable, concurrentInternTest)
+{
+    YAML::KeyTable keys;
+    const int keyCount = 2000;
+
+    std::vector<std::vector<const YAML::KeyTable::Key *>> results(4);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < results.size(); ++t) {
+        threads.emplace_back([&keys, &results, t]() {
+            for (int i = 0; i < keyCount; ++i) {
+                results[t].push_back(keys.intern("key" + std::to_string((i * 7 + t) % keyCount)));
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(keyCount, keys.size());
+    for (const auto& result : results) {
+        for (const YAML::KeyTable::Key *key : result) {
+            ASSERT_EQ(key, keys.find(key->name));
+            ASSERT_EQ(key, keys.get(key->id));
+        }
+    }
+}
+
+TEST(YamlKeyTable, interningAdapterTest)
+{
+    const std::string input("- item : Super Hoop\n"
+                            "  quantity: 1\n"
+                            "- item : Basketball\n"
+                            "  quantity: 4\n");
+
+    YAML::KeyTable keys;
+    KeyCollector collector;
+    YAML::KeyInterningAdapter adapter(keys, &collector);
+    YAML::Parser parser(&adapter);
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+
+    ASSERT_EQ(4, collector.keys.size());
+    ASSERT_EQ(2, keys.size());
+    ASSERT_EQ(collector.keys[0], collector.keys[2]);
+    ASSERT_EQ(collector.keys[1], collector.keys[3]);
+    ASSERT_EQ("quantity", collector.keys[3]->name);
+    ASSERT_NE(input.data() + 9, collector.keys[0]->name.data());
+}
+
+TEST(YamlKeyTable, fullTableTest)
+{
+    const std::string input("item : Super Hoop\n"
+                            "quantity: 1\n"
+                            "price: 450.00\n"
+                            "item : Basketball\n");
+
+    YAML::KeyTable keys(2);
+    ASSERT_NE(nullptr, keys.intern("first"));
+    ASSERT_NE(nullptr, keys.intern("item"));
+    ASSERT_EQ(nullptr, keys.intern("quantity"));
+    ASSERT_EQ(2, keys.size());
+
+    KeyCollector collector;
+    YAML::KeyInterningAdapter adapter(keys, &collector);
+    YAML::Parser parser(&adapter);
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+
+    // Keys past the limit are still delivered, with their scalars
+    const std::vector<std::string> names = {"item", "quantity", "price", "item"};
+    const std::vector<uint32_t> ids = {1, YAML::KeyTable::NoId, YAML::KeyTable::NoId, 1};
+    const std::vector<std::string> scalars = {"Super Hoop", "1", "450.00", "Basketball"};
+    ASSERT_EQ(names, collector.names);
+    ASSERT_EQ(ids, collector.ids);
+    ASSERT_EQ(scalars, collector.scalars);
+    ASSERT_EQ(2, keys.size());
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+
+#include "Document.h"
+#include "LazyDocument.h"
+#include "MappedFile.h"
+
+TEST(YamlLazyDocument, getValueTest)
+{
+    YAML::MappedFile file;
+    ASSERT_TRUE(file.open(TEST_DATA_DIR "/invoice.yml"));
+
+    YAML::LazyDocument document(file.getData(), file.getSize());
+    ASSERT_EQ(29, document.getLineCount());
+
+    std::string_view value;
+    ASSERT_TRUE(document.getValue("invoice", value));
+    ASSERT_EQ("34843", value);
+    ASSERT_TRUE(document.getValue("date", value));
+    ASSERT_EQ("2001-01-23", value);
+    ASSERT_TRUE(document.getValue("bill-to/given", value));
+    ASSERT_EQ("Chris", value);
+    ASSERT_TRUE(document.getValue("bill-to/address/city", value));
+    ASSERT_EQ("Royal Oak", value);
+    ASSERT_TRUE(document.getValue("tax", value));
+    ASSERT_EQ("251.42", value);
+    ASSERT_TRUE(document.getValue("total", value));
+    ASSERT_EQ("4443.52", value);
+    ASSERT_TRUE(value.data() >= file.getData() && value.data() < file.getData() + file.getSize());
+
+    ASSERT_FALSE(document.getValue("city", value));
+    ASSERT_FALSE(document.getValue("bill-to/missing", value));
+    ASSERT_FALSE(document.getValue("product", value));
+    ASSERT_FALSE(document.getValue("", value));
+}
+
+TEST(YamlLazyDocument, materializeTest)
+{
+    const std::string input("# header\n"
+                            "name: Mark McGwire\n"
+                            "stats:\n"
+                            "    hr: 65\n"
+                            "\n"
+                            "    # batting\n"
+                            "    avg: 0.278\n"
+                            "teams:\n"
+                            "    - Cardinals\n"
+                            "    - Athletics\n"
+                            "empty:\n"
+                            "rbi: 147");
+
+    YAML::LazyDocument lazy(input.data(), input.size());
+
+    YAML::Document document;
+    ASSERT_TRUE(lazy.materialize("stats", document));
+    ASSERT_TRUE(document.getRoot()->isMap());
+    ASSERT_EQ(2, document.getRoot()->size());
+    ASSERT_EQ("0.278", document.find("avg")->getValue());
+
+    ASSERT_TRUE(lazy.materialize("teams", document, YAML::DocumentBuilder::Strings::Reference));
+    ASSERT_TRUE(document.getRoot()->isSequence());
+    ASSERT_EQ("Athletics", document.getRoot()->at(1)->getValue());
+
+    ASSERT_TRUE(lazy.materialize("empty", document));
+    ASSERT_TRUE(document.getRoot()->isNull());
+
+    ASSERT_FALSE(lazy.materialize("missing", document));
+
+    ASSERT_TRUE(lazy.materialize("", document));
+    ASSERT_EQ("Mark McGwire", document.find("name")->getValue());
+
+    std::string_view value;
+    ASSERT_TRUE(lazy.getValue("stats/avg", value));
+    ASSERT_EQ("0.278", value);
+    ASSERT_TRUE(lazy.getValue("rbi", value));
+    ASSERT_EQ("147", value);
+}
+
+TEST(YamlLazyDocument, blockScalarTest)
+{
+    const std::string input("a: |\n"
+                            "  b: inner\n"
+                            "  text\n"
+                            "\n"
+                            "b: outer\n"
+                            "c:\n"
+                            "    - d: >-\n"
+                            "        e: folded\n"
+                            "        text\n"
+                            "    - e: last");
+
+    YAML::LazyDocument lazy(input.data(), input.size());
+
+    // Lines of a block scalar are text, not keys
+    std::string_view value;
+    ASSERT_FALSE(lazy.getValue("a/b", value));
+    ASSERT_TRUE(lazy.getValue("a", value));
+    ASSERT_EQ("b: inner\ntext\n", value);
+    ASSERT_TRUE(lazy.getValue("b", value));
+    ASSERT_EQ("outer", value);
+
+    YAML::Document document;
+    ASSERT_TRUE(lazy.materialize("c", document));
+    ASSERT_EQ(2, document.getRoot()->size());
+    ASSERT_EQ("e: folded text", document.getRoot()->at(0)->find("d")->getValue());
+    ASSERT_EQ("last", document.getRoot()->at(1)->find("e")->getValue());
+
+    YAML::MappedFile file;
+    ASSERT_TRUE(file.open(TEST_DATA_DIR "/invoice.yml"));
+    YAML::LazyDocument invoice(file.getData(), file.getSize());
+    ASSERT_TRUE(invoice.getValue("bill-to/address/lines", value));
+    ASSERT_EQ("458 Walkman Dr.\nSuite #292\n", value);
+    ASSERT_TRUE(invoice.getValue("bill-to/address/city", value));
+    ASSERT_EQ("Royal Oak", value);
+}
+
+TEST(YamlLazyDocument, flowCollectionTest)
+{
+    const std::string input("a: [1,\n"
+                            "  b: 2]\n"
+                            "c: [1, 2]\n"
+                            "d: {e: f}  # comment\n"
+                            "g: x\n");
+
+    YAML::LazyDocument lazy(input.data(), input.size());
+
+    // A flow collection is not a scalar, and its lines are not keys
+    std::string_view value;
+    ASSERT_FALSE(lazy.getValue("a", value));
+    ASSERT_FALSE(lazy.getValue("a/b", value));
+    ASSERT_FALSE(lazy.getValue("c", value));
+    ASSERT_TRUE(lazy.getValue("g", value));
+    ASSERT_EQ("x", value);
+
+    YAML::Document document;
+    ASSERT_TRUE(lazy.materialize("c", document));
+    ASSERT_TRUE(document.getRoot()->isSequence());
+    ASSERT_EQ("2", document.getRoot()->at(1)->getValue());
+
+    ASSERT_TRUE(lazy.materialize("a", document));
+    ASSERT_EQ(2, document.getRoot()->size());
+    ASSERT_EQ("2", document.getRoot()->at(1)->find("b")->getValue());
+
+    ASSERT_TRUE(lazy.materialize("d", document));
+    ASSERT_EQ("f", document.find("e")->getValue());
+}
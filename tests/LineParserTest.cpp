@@ -4,6 +4,7 @@
 
 #include "LineParser.h"
 #include "FakeEventObserver.h"
+#include "FakeEventViewObserver.h"
 
 TEST(YamlLineParser, simpleCollectionParserTest)
 {
@@ -78,3 +79,30 @@ TEST(YamlLineParser, parseCollectionWithSpaceBeforeColonTest)
     ASSERT_EQ("0.278", eventObserver.events["avg"].getValue());
     ASSERT_EQ(0, eventObserver.events["avg"].getSpaces());
 }
+
+TEST(YamlLineParser, parseTrailingSpacesViewEventTest)
+{
+    std::stringstream input("Time: 2001-11-23 15:01:42 -5 \t ");
+    input >> std::noskipws;
+
+    Fake::EventViewObserver eventObserver;
+    YAML::LineParser lineParser(&eventObserver);
+    ASSERT_TRUE(lineParser.parse(input));
+
+    ASSERT_EQ(2, eventObserver.events.size());
+    ASSERT_EQ("Time", eventObserver.events.at(0).getValue());
+    ASSERT_EQ("2001-11-23 15:01:42 -5", eventObserver.events.at(1).getValue());
+}
+
+TEST(YamlLineParser, bufferParseEventTest)
+{
+    const char input[] = "    - test event";
+
+    Fake::EventObserver eventObserver;
+    YAML::LineParser lineParser(&eventObserver);
+    ASSERT_TRUE(lineParser.parse(input, sizeof(input) - 1));
+
+    ASSERT_EQ(1, eventObserver.sequences.size());
+    ASSERT_EQ("test event", eventObserver.sequences.at(0).getValue());
+    ASSERT_EQ(4, eventObserver.sequences.at(0).getSpaces());
+}
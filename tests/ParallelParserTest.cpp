@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include "Parser.h"
+#include "ParallelParser.h"
+#include "FakeEventViewObserver.h"
+
+namespace {
+
+std::string
+makeDocument(int items)
+{
+    std::string result;
+    for (int i = 0; i < items; ++i) {
+        result += "- item : Item " + std::to_string(i) + "\r\n";
+        result += "  quantity: " + std::to_string(i % 7) + " # comment\r\n";
+        // A key without a value carries state into the next line
+        result += "  description:\r\n";
+        result += "    long text " + std::to_string(i) + "\r\n";
+        result += "-\r\n";
+        result += "   price: 450.00\r\n";
+    }
+
+    return result;
+}
+
+void
+expectSameEvents(const Fake::EventViewObserver& expected, const Fake::EventViewObserver& actual)
+{
+    ASSERT_EQ(expected.events.size(), actual.events.size());
+    for (size_t i = 0; i < expected.events.size(); ++i) {
+        ASSERT_EQ(expected.events[i].getType(), actual.events[i].getType());
+        ASSERT_EQ(expected.events[i].getValue(), actual.events[i].getValue());
+        ASSERT_EQ(expected.events[i].getSpaces(), actual.events[i].getSpaces());
+    }
+}
+
+}
+
+TEST(YamlParallelParser, sameEventsAsParserTest)
+{
+    const std::string input = makeDocument(2000);
+
+    Fake::EventViewObserver expected;
+    YAML::Parser parser(&expected);
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+
+    for (size_t chunkSize : {1, 37, 1000, 4096}) {
+        Fake::EventViewObserver actual;
+        YAML::ParallelParser parallelParser(&actual, 4, chunkSize);
+        ASSERT_TRUE(parallelParser.parse(input.data(), input.size()));
+
+        expectSameEvents(expected, actual);
+    }
+}
+
+TEST(YamlParallelParser, stopsAtFirstErrorTest)
+{
+    std::string input = makeDocument(500);
+    input += "- a b: c\n";
+    input += makeDocument(500);
+
+    Fake::EventViewObserver expected;
+    YAML::Parser parser(&expected);
+    ASSERT_FALSE(parser.parse(input.data(), input.size()));
+
+    Fake::EventViewObserver actual;
+    YAML::ParallelParser parallelParser(&actual, 3, 512);
+    ASSERT_FALSE(parallelParser.parse(input.data(), input.size()));
+
+    expectSameEvents(expected, actual);
+}
+
+TEST(YamlParallelParser, blockScalarsAcrossChunksTest)
+{
+    std::string input;
+    for (int i = 0; i < 200; ++i) {
+        input += "- script: |\n";
+        for (int line = 0; line < i % 13; ++line) {
+            input += "    echo " + std::to_string(line) + "\n";
+        }
+        input += "  folded: >\n"
+                 "    a\n"
+                 "    b\n";
+    }
+
+    Fake::EventViewObserver expected;
+    YAML::Parser parser(&expected);
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+    ASSERT_EQ("a b\n", expected.events.back().getValue());
+
+    for (size_t chunkSize : {1, 37, 1000}) {
+        Fake::EventViewObserver actual;
+        YAML::ParallelParser parallelParser(&actual, 4, chunkSize);
+        ASSERT_TRUE(parallelParser.parse(input.data(), input.size()));
+
+        expectSameEvents(expected, actual);
+    }
+}
+
+TEST(YamlParallelParser, noTrailingNewlineTest)
+{
+    std::string input;
+    for (int i = 0; i < 50; ++i) {
+        input += "k" + std::to_string(i) + ": v" + std::to_string(i) + "\n";
+    }
+
+    for (const char *last : {"lastkey: lastvalue", "block: |\n  first\n  last line"}) {
+        const std::string document = input + last;
+
+        Fake::EventViewObserver expected;
+        YAML::Parser parser(&expected);
+        ASSERT_TRUE(parser.parse(document.data(), document.size()));
+
+        for (size_t chunkSize : {1, 64, 4096}) {
+            Fake::EventViewObserver actual;
+            YAML::ParallelParser parallelParser(&actual, 4, chunkSize);
+            ASSERT_TRUE(parallelParser.parse(document.data(), document.size()));
+
+            expectSameEvents(expected, actual);
+        }
+    }
+
+    // Events of the last line point into the input, as they do with Parser
+    const std::string document = input + "lastkey: lastvalue";
+    Fake::EventViewObserver observer;
+    YAML::ParallelParser parallelParser(&observer, 4, 64);
+    ASSERT_TRUE(parallelParser.parse(document.data(), document.size()));
+    ASSERT_EQ("lastvalue", observer.events.back().getValue());
+    ASSERT_EQ(document.data() + document.size() - 9, observer.events.back().getData());
+}
+
+TEST(YamlParallelParser, emptyInputTest)
+{
+    Fake::EventViewObserver observer;
+    YAML::ParallelParser parallelParser(&observer, 2);
+    ASSERT_TRUE(parallelParser.parse("", 0));
+    ASSERT_TRUE(observer.events.empty());
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+#include "BasicParser.h"
+#include "FakeEventViewObserver.h"
+
+TEST(YamlParseStatistics, countersTest)
+{
+    const std::string input("# Products purchased\n"
+                            "- item : Super Hoop\n"
+                            "  quantity: 1\n"
+                            "bill-to: Chris\n"
+                            "    city : Royal Oak\n"
+                            "        postal : 48046");
+
+    Fake::EventViewObserver observer;
+    YAML::InstrumentedParser parser(&observer);
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+
+    const YAML::ParseStatistics& statistics = parser.getStatistics();
+    ASSERT_EQ(6, statistics.lines);
+    ASSERT_EQ(input.size() - 5, statistics.bytes);
+    ASSERT_EQ(5, statistics.mapItems);
+    ASSERT_EQ(5, statistics.scalars);
+    ASSERT_EQ(1, statistics.sequenceItems);
+    ASSERT_EQ(8, statistics.maxSpaces);
+    ASSERT_EQ(10, statistics.longestScalar);
+    ASSERT_EQ(statistics.mapItems + statistics.scalars + statistics.sequenceItems, observer.events.size());
+
+    ASSERT_EQ(6, statistics.getSteps(YAML::AbstractParseState::State::Init));
+    ASSERT_EQ(1, statistics.getSteps(YAML::AbstractParseState::State::Comments));
+    ASSERT_EQ(1, statistics.getSteps(YAML::AbstractParseState::State::Sequence));
+    ASSERT_EQ(0, statistics.getSteps(YAML::AbstractParseState::State::Error));
+    ASSERT_LT(0, statistics.getTime(YAML::ParsePhase::Index).count());
+    ASSERT_LT(0, statistics.getTime(YAML::ParsePhase::Lines).count());
+}
+
+TEST(YamlParseStatistics, accumulateTest)
+{
+    const std::string input("hr: 65\navg: 0.278\n");
+
+    YAML::InstrumentedParser parser;
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+    parser.reset();
+
+    std::stringstream stream(input);
+    ASSERT_TRUE(parser.parse(stream));
+    ASSERT_EQ(4, parser.getStatistics().lines);
+    ASSERT_EQ(4, parser.getStatistics().mapItems);
+
+    parser.getStatistics().clear();
+    ASSERT_EQ(0, parser.getStatistics().lines);
+    ASSERT_EQ(0, parser.getStatistics().getTime(YAML::ParsePhase::Lines).count());
+
+    ASSERT_FALSE(parser.parse("- a b: c", 8));
+    ASSERT_EQ(1, parser.getStatistics().getSteps(YAML::AbstractParseState::State::SequenceScalar));
+}
+
+TEST(YamlParseStatistics, noStatisticsTest)
+{
+    static_assert(sizeof(YAML::BasicParser<YAML::NullObserver>) <
+            sizeof(YAML::BasicParser<YAML::NullObserver, YAML::ParseStatistics>), "");
+    ASSERT_TRUE(std::is_empty<YAML::NoStatistics>::value);
+}
@@ -1,8 +1,16 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
 #include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
 
 #include "Parser.h"
+#include "AbstractScalarChunkObserver.h"
 #include "FakeEventObserver.h"
+#include "FakeEventViewObserver.h"
 
 TEST(YamlParser, collectionTest)
 {
@@ -160,3 +168,599 @@ TEST(YamlParser, parseCompactSequenceOfMappingTest)
     ASSERT_EQ("1", observer.events["quantity"].getValue());
     ASSERT_EQ(2, observer.events["quantity"].getSpaces());
 }
+
+TEST(YamlParser, viewEventsTest)
+{
+    Fake::EventViewObserver observer;
+    YAML::Parser parser(&observer);
+
+    std::stringstream input("- item : Super Hoop  \r\n"
+                            "  quantity: 1 # one\r\n");
+    ASSERT_TRUE(parser.parse(input));
+    ASSERT_EQ(5, observer.events.size());
+
+    using Type = Fake::EventViewObserver::Event::Type;
+    ASSERT_EQ(Type::SequenceItem, observer.events[0].getType());
+    ASSERT_EQ(0, observer.events[0].getSpaces());
+
+    ASSERT_EQ(Type::MapItem, observer.events[1].getType());
+    ASSERT_EQ("item", observer.events[1].getValue());
+    ASSERT_EQ(2, observer.events[1].getSpaces());
+
+    ASSERT_EQ(Type::Scalar, observer.events[2].getType());
+    ASSERT_EQ("Super Hoop", observer.events[2].getValue());
+
+    ASSERT_EQ(Type::MapItem, observer.events[3].getType());
+    ASSERT_EQ("quantity", observer.events[3].getValue());
+    ASSERT_EQ(2, observer.events[3].getSpaces());
+
+    ASSERT_EQ(Type::Scalar, observer.events[4].getType());
+    ASSERT_EQ("1", observer.events[4].getValue());
+}
+
+TEST(YamlParser, bufferParseTest)
+{
+    const std::string input("hr: 65 # Home runs\r\n"
+                            "avg : 0.278\r\n"
+                            "- item : Big Shoes\r\n"
+                            "  quantity: 1\n");
+    Fake::EventObserver observer;
+
+    YAML::Parser parser(&observer);
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+
+    ASSERT_EQ(4, observer.events.size());
+    ASSERT_EQ("65", observer.events["hr"].getValue());
+    ASSERT_EQ("0.278", observer.events["avg"].getValue());
+    ASSERT_EQ("Big Shoes", observer.events["item"].getValue());
+    ASSERT_EQ(2, observer.events["item"].getSpaces());
+    ASSERT_EQ("1", observer.events["quantity"].getValue());
+    ASSERT_EQ(1, observer.sequences.size());
+}
+
+TEST(YamlParser, bufferParseViewsIntoInputTest)
+{
+    const std::string input("name: Mark McGwire\n"
+                            "- Sammy Sosa");
+    Fake::EventViewObserver observer;
+
+    YAML::Parser parser(&observer);
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+
+    ASSERT_EQ(4, observer.events.size());
+    ASSERT_EQ(input.data(), observer.events[0].getData());
+    ASSERT_EQ(input.data() + 6, observer.events[1].getData());
+    ASSERT_EQ("Sammy Sosa", observer.events[3].getValue());
+    ASSERT_EQ(input.data() + 21, observer.events[3].getData());
+}
+
+TEST(YamlParser, errorInLastLineTest)
+{
+    const std::string input("hr: 65\n"
+                            "- a b: c");
+    Fake::EventObserver observer;
+
+    YAML::Parser parser(&observer);
+    ASSERT_FALSE(parser.parse(input.data(), input.size()));
+
+    std::stringstream stream(input);
+    YAML::Parser streamParser(&observer);
+    ASSERT_FALSE(streamParser.parse(stream));
+}
+
+TEST(YamlParser, parseFileTest)
+{
+    const std::string path = TEST_DATA_DIR "/win.yml";
+
+    Fake::EventViewObserver fileObserver;
+    YAML::Parser fileParser(&fileObserver);
+    bool fileResult = fileParser.parseFile(path);
+
+    std::ifstream input(path, std::ios_base::binary);
+    Fake::EventViewObserver streamObserver;
+    YAML::Parser streamParser(&streamObserver);
+    ASSERT_EQ(streamParser.parse(input), fileResult);
+
+    ASSERT_FALSE(fileObserver.events.empty());
+    ASSERT_EQ(streamObserver.events.size(), fileObserver.events.size());
+    for (size_t i = 0; i < fileObserver.events.size(); ++i) {
+        ASSERT_EQ(streamObserver.events[i].getType(), fileObserver.events[i].getType());
+        ASSERT_EQ(streamObserver.events[i].getValue(), fileObserver.events[i].getValue());
+        ASSERT_EQ(streamObserver.events[i].getSpaces(), fileObserver.events[i].getSpaces());
+    }
+}
+
+TEST(YamlParser, parseMissingFileTest)
+{
+    YAML::Parser parser;
+    ASSERT_FALSE(parser.parseFile(TEST_DATA_DIR "/missing.yml"));
+}
+
+TEST(YamlParser, bufferParseAcrossIndexWindowsTest)
+{
+    std::string input;
+    for (int i = 0; i < 20000; ++i) {
+        input += "- item : Big Shoes # comment\r\n";
+    }
+    input += "long: " + std::string(200000, 'x') + "\n";
+    input += "hr: 65";
+
+    Fake::EventObserver observer;
+    YAML::Parser parser(&observer);
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+
+    ASSERT_EQ(20000, observer.sequences.size());
+    ASSERT_EQ("Big Shoes", observer.events["item"].getValue());
+    ASSERT_EQ(200000, observer.events["long"].getValue().size());
+    ASSERT_EQ("65", observer.events["hr"].getValue());
+}
+
+TEST(YamlParser, feedFragmentsTest)
+{
+    const std::string input("# Products purchased\r\n"
+                            "- item : Super Hoop\r\n"
+                            "  quantity: 1\r\n"
+                            "-\n"
+                            "   name: Mark McGwire\n"
+                            "hr: 65 # Home runs\n"
+                            "avg: 0.278");
+
+    Fake::EventViewObserver expected;
+    YAML::Parser parser(&expected);
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+
+    for (size_t fragmentSize = 1; fragmentSize <= input.size(); ++fragmentSize) {
+        Fake::EventViewObserver observer;
+        YAML::Parser pushParser(&observer);
+        for (size_t offset = 0; offset < input.size(); offset += fragmentSize) {
+            ASSERT_TRUE(pushParser.feed(input.data() + offset,
+                        std::min(fragmentSize, input.size() - offset)));
+        }
+        ASSERT_TRUE(pushParser.finish());
+
+        ASSERT_EQ(expected.events.size(), observer.events.size());
+        for (size_t i = 0; i < expected.events.size(); ++i) {
+            ASSERT_EQ(expected.events[i].getType(), observer.events[i].getType());
+            ASSERT_EQ(expected.events[i].getValue(), observer.events[i].getValue());
+            ASSERT_EQ(expected.events[i].getSpaces(), observer.events[i].getSpaces());
+        }
+    }
+}
+
+TEST(YamlParser, finishInPlaceTest)
+{
+    const std::string input("hr: 65\n"
+                            "avg: 0.278");
+
+    Fake::EventViewObserver observer;
+    YAML::Parser parser(&observer);
+    ASSERT_TRUE(parser.feed(input.data(), 3));
+    ASSERT_TRUE(parser.finish(input.data() + 3, input.size() - 3));
+    ASSERT_EQ(4, observer.events.size());
+
+    // Without a partial line buffered the last line is not copied
+    ASSERT_TRUE(parser.finish(input.data(), input.size()));
+    ASSERT_EQ(8, observer.events.size());
+    ASSERT_EQ("0.278", observer.events.back().getValue());
+    ASSERT_EQ(input.data() + input.size() - 5, observer.events.back().getData());
+
+    // Errors are reported as parse() reports them
+    const std::string unclosed("key: [a,\n  b");
+    YAML::Parser bufferParser;
+    ASSERT_FALSE(bufferParser.parse(unclosed.data(), unclosed.size()));
+    ASSERT_FALSE(parser.finish(unclosed.data(), unclosed.size()));
+    ASSERT_EQ(bufferParser.getError().line, parser.getError().line);
+    ASSERT_EQ(unclosed.size(), parser.getError().offset);
+}
+
+TEST(YamlParser, feedEmitsCompleteLinesTest)
+{
+    Fake::EventObserver observer;
+    YAML::Parser parser(&observer);
+
+    ASSERT_TRUE(parser.feed("hr: 6", 5));
+    ASSERT_TRUE(observer.events.empty());
+
+    ASSERT_TRUE(parser.feed("5\navg: 0.2", 10));
+    ASSERT_EQ("65", observer.events["hr"].getValue());
+    ASSERT_EQ(0, observer.events.count("avg"));
+
+    ASSERT_TRUE(parser.finish());
+    ASSERT_EQ("0.2", observer.events["avg"].getValue());
+}
+
+TEST(YamlParser, feedErrorTest)
+{
+    Fake::EventObserver observer;
+    YAML::Parser parser(&observer);
+
+    ASSERT_FALSE(parser.feed("- a b: c\nhr: 65\n", 17));
+    ASSERT_FALSE(parser.feed("avg: 0.278\n", 11));
+    ASSERT_FALSE(parser.finish());
+    ASSERT_EQ(0, observer.events.count("hr"));
+}
+
+TEST(YamlParser, concreteObserverTest)
+{
+    const std::string input("- item : Super Hoop\n"
+                            "  quantity: 1\n"
+                            "- item : Basketball\n"
+                            "  quantity: 4");
+
+    Fake::EventViewObserver expected;
+    YAML::Parser parser(&expected);
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+
+    Fake::EventViewObserver observer;
+    YAML::BasicParser<Fake::EventViewObserver> basicParser(&observer);
+    ASSERT_TRUE(basicParser.parse(input.data(), input.size()));
+
+    ASSERT_EQ(expected.events.size(), observer.events.size());
+    for (size_t i = 0; i < expected.events.size(); ++i) {
+        ASSERT_EQ(expected.events[i].getType(), observer.events[i].getType());
+        ASSERT_EQ(expected.events[i].getData(), observer.events[i].getData());
+        ASSERT_EQ(expected.events[i].getSpaces(), observer.events[i].getSpaces());
+    }
+}
+
+TEST(YamlParser, syntaxValidatorTest)
+{
+    const std::string inputs[] = {
+        "hr: 65\navg: 0.278\n",
+        "- a b: c\nhr: 65\n",
+        "# comment\n- Mark McGwire\n- Sammy Sosa",
+        "key: value\n-x\n",
+    };
+
+    for (const auto& input : inputs) {
+        YAML::Parser parser;
+        YAML::SyntaxValidator validator;
+        ASSERT_EQ(parser.parse(input.data(), input.size()), validator.parse(input.data(), input.size()));
+    }
+
+    YAML::SyntaxValidator validator;
+    ASSERT_EQ(YAML::Parser().parseFile(TEST_DATA_DIR "/win.yml"), validator.parseFile(TEST_DATA_DIR "/win.yml"));
+}
+
+TEST(YamlParser, errorLocationTest)
+{
+    const std::string input("hr: 65\n"
+                            "avg: 0.278\n"
+                            "  - item: x\n"
+                            "  -x\n"
+                            "rbi: 147\n");
+
+    YAML::Parser parser;
+    ASSERT_FALSE(parser.parse(input.data(), input.size()));
+
+    const YAML::ParseError& error = parser.getError();
+    ASSERT_EQ(4, error.line);
+    ASSERT_EQ(4, error.column);
+    ASSERT_EQ(input.find("-x") + 1, error.offset);
+    ASSERT_EQ(YAML::AbstractParseState::State::Sequence, error.state);
+
+    std::stringstream stream(input);
+    YAML::Parser streamParser;
+    ASSERT_FALSE(streamParser.parse(stream));
+    ASSERT_EQ(error.line, streamParser.getError().line);
+    ASSERT_EQ(error.column, streamParser.getError().column);
+    ASSERT_EQ(error.offset, streamParser.getError().offset);
+
+    for (size_t fragmentSize : {1, 3, 7}) {
+        YAML::Parser pushParser;
+        bool result = true;
+        for (size_t offset = 0; result && offset < input.size(); offset += fragmentSize) {
+            result = pushParser.feed(input.data() + offset, std::min(fragmentSize, input.size() - offset));
+        }
+
+        ASSERT_FALSE(result && pushParser.finish());
+        ASSERT_EQ(error.line, pushParser.getError().line);
+        ASSERT_EQ(error.column, pushParser.getError().column);
+        ASSERT_EQ(error.offset, pushParser.getError().offset);
+    }
+}
+
+TEST(YamlParser, errorStateTest)
+{
+    YAML::Parser parser;
+    ASSERT_FALSE(parser.parse("key:value", 9));
+    ASSERT_EQ(1, parser.getError().line);
+    ASSERT_EQ(5, parser.getError().column);
+    ASSERT_EQ(YAML::AbstractParseState::State::Map, parser.getError().state);
+
+    parser.reset();
+    ASSERT_FALSE(parser.parse("a: b\n- a b: c", 13));
+    ASSERT_EQ(2, parser.getError().line);
+    ASSERT_EQ(3, parser.getError().column);
+    ASSERT_EQ(7, parser.getError().offset);
+    ASSERT_EQ(YAML::AbstractParseState::State::SequenceScalar, parser.getError().state);
+
+    ASSERT_FALSE(parser.parse("hr: 65\n", 7));
+    ASSERT_EQ(1, parser.getError().line);
+    ASSERT_EQ(1, parser.getError().column);
+    ASSERT_EQ(YAML::AbstractParseState::State::Error, parser.getError().state);
+}
+
+TEST(YamlParser, emptyInputTest)
+{
+    YAML::Parser parser;
+    ASSERT_TRUE(parser.parse(nullptr, 0));
+    ASSERT_TRUE(parser.feed(nullptr, 0));
+    ASSERT_TRUE(parser.finish());
+}
+
+namespace {
+
+// Collects block scalars through the chunk interface
+class ChunkObserver : public Fake::EventViewObserver, public YAML::AbstractScalarChunkObserver {
+public:
+    void newScalarChunk(std::string_view chunk, bool last) override {
+        this->chunks.emplace_back(chunk);
+        this->value.append(chunk);
+        if (last) {
+            newScalar(this->value);
+            this->value.clear();
+        }
+    }
+public:
+    std::vector<std::string> chunks;
+    std::string value;
+};
+
+}
+
+TEST(YamlParser, blockScalarTest)
+{
+    const std::string input("literal: |\n"
+                            "  echo a\n"
+                            "    indented\n"
+                            "\n"
+                            "  echo b\r\n"
+                            "folded: >-\n"
+                            "  one\n"
+                            "  two\n"
+                            "\n"
+                            "  three\n"
+                            "    more\n"
+                            "  four\n"
+                            "steps:\n"
+                            "    - |+\n"
+                            "      kept\n"
+                            "\n"
+                            "    - name: x\n"
+                            "      run: | # comment\n"
+                            "        last\n");
+
+    using Type = Fake::EventViewObserver::Event::Type;
+    const std::pair<Type, const char *> expected[] = {
+        {Type::MapItem, "literal"},
+        {Type::Scalar, "echo a\n  indented\n\necho b\n"},
+        {Type::MapItem, "folded"},
+        {Type::Scalar, "one two\nthree\n  more\nfour"},
+        {Type::MapItem, "steps"},
+        {Type::SequenceItem, ""},
+        {Type::Scalar, "kept\n\n"},
+        {Type::SequenceItem, ""},
+        {Type::MapItem, "name"},
+        {Type::Scalar, "x"},
+        {Type::MapItem, "run"},
+        {Type::Scalar, "last\n"},
+    };
+
+    Fake::EventViewObserver observer;
+    YAML::Parser parser(&observer);
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+
+    ASSERT_EQ(std::size(expected), observer.events.size());
+    for (size_t i = 0; i < observer.events.size(); ++i) {
+        ASSERT_EQ(expected[i].first, observer.events[i].getType());
+        ASSERT_EQ(expected[i].second, observer.events[i].getValue());
+    }
+
+    ASSERT_EQ(6, observer.events[10].getSpaces());
+
+    std::stringstream stream(input);
+    Fake::EventViewObserver streamObserver;
+    YAML::Parser streamParser(&streamObserver);
+    ASSERT_TRUE(streamParser.parse(stream));
+
+    Fake::EventViewObserver pushObserver;
+    YAML::Parser pushParser(&pushObserver);
+    for (size_t offset = 0; offset < input.size(); offset += 5) {
+        ASSERT_TRUE(pushParser.feed(input.data() + offset, std::min<size_t>(5, input.size() - offset)));
+    }
+    ASSERT_TRUE(pushParser.finish());
+
+    ChunkObserver chunkObserver;
+    YAML::Parser chunkParser(&chunkObserver);
+    ASSERT_TRUE(chunkParser.parse(input.data(), input.size()));
+
+    for (const auto *other : {&streamObserver, &pushObserver, static_cast<Fake::EventViewObserver *>(&chunkObserver)}) {
+        ASSERT_EQ(observer.events.size(), other->events.size());
+        for (size_t i = 0; i < observer.events.size(); ++i) {
+            ASSERT_EQ(observer.events[i].getType(), other->events[i].getType());
+            ASSERT_EQ(observer.events[i].getValue(), other->events[i].getValue());
+            ASSERT_EQ(observer.events[i].getSpaces(), other->events[i].getSpaces());
+        }
+    }
+}
+
+TEST(YamlParser, blockScalarChunksTest)
+{
+    std::string input("blob: |\n");
+    std::string value;
+    for (int i = 0; i < 10000; ++i) {
+        std::string line = "  TUlJQ2lqQ0NBZk9nQXdJQkFnSUpBTUNz" + std::to_string(i);
+        input += line + "\n";
+        value += line.substr(2) + "\n";
+    }
+    input += "next: value\n";
+
+    ChunkObserver observer;
+    YAML::Parser parser(&observer);
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+
+    ASSERT_EQ(4, observer.events.size());
+    ASSERT_EQ(value, observer.events[1].getValue());
+    ASSERT_EQ("value", observer.events[3].getValue());
+
+    // Each line and each line break is a chunk, plus the closing one
+    ASSERT_EQ(20001, observer.chunks.size());
+    ASSERT_TRUE(observer.chunks.back().empty());
+}
+
+TEST(YamlParser, blockScalarHeaderTest)
+{
+    const std::string inputs[] = {
+        "key: |x\n",
+        "key: | x\n",
+        "key: ||\n",
+        "key: |-+\n",
+    };
+
+    for (const auto& input : inputs) {
+        Fake::EventViewObserver observer;
+        YAML::Parser parser(&observer);
+        ASSERT_TRUE(parser.parse(input.data(), input.size()));
+        ASSERT_TRUE(parser.isIdle());
+        ASSERT_EQ(2, observer.events.size());
+        ASSERT_EQ(input.substr(5, input.size() - 6), observer.events[1].getValue());
+    }
+
+    // Explicit indentation keeps the leading spaces of the first line
+    const std::string input("key: |1\n"
+                            "   two spaces\n"
+                            " \n"
+                            "next: x\n");
+    Fake::EventViewObserver observer;
+    YAML::Parser parser(&observer);
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+    ASSERT_EQ(4, observer.events.size());
+    ASSERT_EQ("  two spaces\n", observer.events[1].getValue());
+
+    // Nothing is emitted for an empty block
+    const std::string empty("key: |\n"
+                            "next: x\n");
+    Fake::EventViewObserver emptyObserver;
+    YAML::Parser emptyParser(&emptyObserver);
+    ASSERT_TRUE(emptyParser.parse(empty.data(), empty.size()));
+    ASSERT_EQ(3, emptyObserver.events.size());
+}
+
+TEST(YamlParser, flowCollectionTest)
+{
+    const std::string input("key: {a: 1, b: [x, \"y, z\"], c}\n"
+                            "list:\n"
+                            "  - [k: v, [m, n]] # comment\n"
+                            "multi: [1,\n"
+                            "    2]\n"
+                            "[top, {\"q\":0}]\n");
+
+    using Type = Fake::EventViewObserver::Event::Type;
+    const std::tuple<Type, const char *, int> expected[] = {
+        {Type::MapItem, "key", 0},
+        {Type::MapItem, "a", 1},
+        {Type::Scalar, "1", 0},
+        {Type::MapItem, "b", 1},
+        {Type::SequenceItem, "", 2},
+        {Type::Scalar, "x", 0},
+        {Type::SequenceItem, "", 2},
+        {Type::Scalar, "\"y, z\"", 0},
+        {Type::MapItem, "c", 1},
+        {Type::MapItem, "list", 0},
+        {Type::SequenceItem, "", 0},
+        {Type::SequenceItem, "", 1},
+        {Type::MapItem, "k", 2},
+        {Type::Scalar, "v", 0},
+        {Type::SequenceItem, "", 1},
+        {Type::SequenceItem, "", 2},
+        {Type::Scalar, "m", 0},
+        {Type::SequenceItem, "", 2},
+        {Type::Scalar, "n", 0},
+        {Type::MapItem, "multi", 0},
+        {Type::SequenceItem, "", 1},
+        {Type::Scalar, "1", 0},
+        {Type::SequenceItem, "", 1},
+        {Type::Scalar, "2", 0},
+        {Type::SequenceItem, "", 0},
+        {Type::Scalar, "top", 0},
+        {Type::SequenceItem, "", 0},
+        {Type::MapItem, "\"q\"", 1},
+        {Type::Scalar, "0", 0},
+    };
+
+    Fake::EventViewObserver observer;
+    YAML::Parser parser(&observer);
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+
+    ASSERT_EQ(std::size(expected), observer.events.size());
+    for (size_t i = 0; i < observer.events.size(); ++i) {
+        ASSERT_EQ(std::get<0>(expected[i]), observer.events[i].getType());
+        ASSERT_EQ(std::get<1>(expected[i]), observer.events[i].getValue());
+        if (std::get<0>(expected[i]) != Type::Scalar) {
+            ASSERT_EQ(std::get<2>(expected[i]), observer.events[i].getSpaces());
+        }
+    }
+
+    // Scalars are views into the input
+    ASSERT_EQ(input.data() + input.find("\"y, z\""), observer.events[7].getData());
+}
+
+TEST(YamlParser, flowCollectionErrorTest)
+{
+    const std::string inputs[] = {
+        "key: [a, b} \n",
+        "key: {a: 1} x\n",
+        "key: {[a]: 1}\n",
+        "key: ['a, b]\n",
+        "key: [a]]\n",
+        "x: [,]\n",
+        "x: {a: 1,,}\n",
+        "x: [a,,b]\n",
+        "x: {,}\n",
+    };
+
+    // Trailing commas and entries without a value are fine
+    const std::string valid("x: [a, b,]\n"
+                            "y: {a: 1,}\n"
+                            "z: {a: , b}\n");
+    YAML::SyntaxValidator validValidator;
+    ASSERT_TRUE(validValidator.parse(valid.data(), valid.size()));
+
+    for (const auto& input : inputs) {
+        YAML::Parser parser;
+        YAML::SyntaxValidator validator;
+        ASSERT_FALSE(parser.parse(input.data(), input.size()));
+        ASSERT_FALSE(validator.parse(input.data(), input.size()));
+        ASSERT_EQ(1, parser.getError().line);
+        ASSERT_EQ(YAML::AbstractParseState::State::FlowCollection, parser.getError().state);
+    }
+
+    // Still open at the end of the input
+    const std::string input("key: [a,\n"
+                            "  b\n");
+    YAML::Parser parser;
+    ASSERT_FALSE(parser.parse(input.data(), input.size()));
+    ASSERT_EQ(3, parser.getError().line);
+    ASSERT_EQ(input.size(), parser.getError().offset);
+    ASSERT_EQ(YAML::AbstractParseState::State::FlowCollection, parser.getError().state);
+
+    YAML::Parser pushParser;
+    ASSERT_TRUE(pushParser.feed(input.data(), input.size()));
+    ASSERT_FALSE(pushParser.isIdle());
+    ASSERT_FALSE(pushParser.finish());
+    ASSERT_EQ(input.size(), pushParser.getError().offset);
+
+    // Stream mode reports the same position as the buffer and feed modes
+    for (const std::string document : {"a: 1\nf: [1, 2\n", "a: 1\nf: [1, 2"}) {
+        YAML::Parser bufferParser;
+        ASSERT_FALSE(bufferParser.parse(document.data(), document.size()));
+
+        std::stringstream stream(document);
+        YAML::Parser streamParser;
+        ASSERT_FALSE(streamParser.parse(stream));
+        ASSERT_EQ(document.size(), streamParser.getError().offset);
+        ASSERT_EQ(bufferParser.getError().offset, streamParser.getError().offset);
+        ASSERT_EQ(bufferParser.getError().line, streamParser.getError().line);
+    }
+}
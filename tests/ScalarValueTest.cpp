@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "Document.h"
+#include "DocumentBuilder.h"
+#include "Parser.h"
+#include "ScalarValue.h"
+#include "TypedScalarAdapter.h"
+
+namespace {
+
+class ScalarCollector : public YAML::AbstractTypedEventObserver {
+public:
+    void newMapItem(std::string_view, int) override {
+    }
+
+    void newScalar(const YAML::ScalarValue& scalar) override {
+        this->scalars.push_back(scalar);
+    }
+
+    void newSequenceItem(int) override {
+    }
+public:
+    std::vector<YAML::ScalarValue> scalars;
+};
+
+}
+
+TEST(YamlScalarValue, classifyTest)
+{
+    using Type = YAML::ScalarValue::Type;
+
+    for (const char *text : {"~", "null", "Null", "NULL"}) {
+        ASSERT_EQ(Type::Null, YAML::ScalarValue::classify(text).getType());
+    }
+
+    ASSERT_TRUE(YAML::ScalarValue::classify("True").getBool());
+    ASSERT_FALSE(YAML::ScalarValue::classify("false").getBool());
+    ASSERT_EQ(Type::Bool, YAML::ScalarValue::classify("FALSE").getType());
+
+    ASSERT_EQ(65, YAML::ScalarValue::classify("65").getInteger());
+    ASSERT_EQ(-12, YAML::ScalarValue::classify("-12").getInteger());
+    ASSERT_EQ(12, YAML::ScalarValue::classify("+12").getInteger());
+    ASSERT_EQ(255, YAML::ScalarValue::classify("0xff").getInteger());
+    ASSERT_EQ(8, YAML::ScalarValue::classify("0o10").getInteger());
+    ASSERT_EQ(65.0, YAML::ScalarValue::classify("65").getFloat());
+
+    ASSERT_EQ(Type::Float, YAML::ScalarValue::classify("0.278").getType());
+    ASSERT_DOUBLE_EQ(0.278, YAML::ScalarValue::classify("0.278").getFloat());
+    ASSERT_DOUBLE_EQ(-0.5, YAML::ScalarValue::classify("-.5").getFloat());
+    ASSERT_DOUBLE_EQ(1200.0, YAML::ScalarValue::classify("1.2e+3").getFloat());
+    ASSERT_DOUBLE_EQ(1e20, YAML::ScalarValue::classify("100000000000000000000").getFloat());
+    ASSERT_TRUE(std::isinf(YAML::ScalarValue::classify("-.inf").getFloat()));
+    ASSERT_TRUE(std::isnan(YAML::ScalarValue::classify(".NaN").getFloat()));
+
+    for (const char *text : {"nothing", "2001-01-23", "1.2.3", "0x", "-0x10", "-.nan", ".", "-", "true!", "Royal Oak",
+                "12 monkeys", "inf", "1e", "0x-5", "0o-7", "0x+5"}) {
+        ASSERT_EQ(Type::String, YAML::ScalarValue::classify(text).getType()) << text;
+        ASSERT_EQ(text, YAML::ScalarValue::classify(text).getText());
+    }
+}
+
+TEST(YamlScalarValue, typedScalarAdapterTest)
+{
+    const std::string input("hr: 65\n"
+                            "avg: 0.278\n"
+                            "active: true\n"
+                            "team: Cardinals\n");
+
+    ScalarCollector collector;
+    YAML::TypedScalarAdapter adapter(&collector);
+    YAML::Parser parser(&adapter);
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+
+    ASSERT_EQ(4, collector.scalars.size());
+    ASSERT_EQ(65, collector.scalars[0].getInteger());
+    ASSERT_DOUBLE_EQ(0.278, collector.scalars[1].getFloat());
+    ASSERT_TRUE(collector.scalars[2].getBool());
+    ASSERT_EQ(YAML::ScalarValue::Type::String, collector.scalars[3].getType());
+
+    YAML::Document document;
+    YAML::DocumentBuilder builder(document);
+    YAML::Parser documentParser(&builder);
+    ASSERT_TRUE(documentParser.parse(input.data(), input.size()));
+    ASSERT_EQ(65, document.find("hr")->getScalarValue().getInteger());
+}
@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include <iterator>
+#include <random>
+#include <string>
+
+#include "BasicParser.h"
+#include "SelectiveParser.h"
+#include "FakeEventViewObserver.h"
+
+namespace {
+
+// Events of Parser for the input, filtered through the same paths
+bool
+filterParse(const std::string& input, std::initializer_list<const char *> paths, Fake::EventViewObserver& observer)
+{
+    YAML::PathFilter filter(&observer);
+    for (const char *path : paths) {
+        filter.addPath(path);
+    }
+
+    YAML::BasicParser<YAML::PathFilter> parser(&filter);
+    return parser.parse(input.data(), input.size());
+}
+
+void
+expectSameEvents(const std::string& input, std::initializer_list<const char *> paths)
+{
+    Fake::EventViewObserver expected;
+    if (!filterParse(input, paths, expected)) {
+        return;
+    }
+
+    Fake::EventViewObserver actual;
+    YAML::SelectiveParser parser(&actual);
+    for (const char *path : paths) {
+        parser.addPath(path);
+    }
+
+    ASSERT_TRUE(parser.parse(input.data(), input.size())) << input;
+    ASSERT_EQ(expected.events.size(), actual.events.size()) << input;
+    for (size_t i = 0; i < expected.events.size(); ++i) {
+        ASSERT_EQ(expected.events[i].getType(), actual.events[i].getType()) << input;
+        ASSERT_EQ(expected.events[i].getValue(), actual.events[i].getValue()) << input;
+        ASSERT_EQ(expected.events[i].getSpaces(), actual.events[i].getSpaces()) << input;
+    }
+}
+
+}
+
+TEST(YamlSelectiveParser, pathsTest)
+{
+    const std::string input("invoice: 34843\n"
+                            "bill-to: &id001\n"
+                            "    given : Chris\n"
+                            "    address: home\n"
+                            "        lines: 458 Walkman Dr.\n"
+                            "        city : Royal Oak\n"
+                            "    family : Dumars\n"
+                            "product: list\n"
+                            "    - sku : BL394D\n"
+                            "      quantity : 4\n"
+                            "    - sku : BL4438H\n"
+                            "      quantity : 1\n"
+                            "tax : 251.42\n");
+
+    Fake::EventViewObserver observer;
+    YAML::SelectiveParser parser(&observer);
+    parser.addPath("bill-to/address/city");
+    parser.addPath("product/sku");
+    parser.addPath("tax");
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+
+    using Type = Fake::EventViewObserver::Event::Type;
+    const std::pair<Type, const char *> expected[] = {
+        {Type::MapItem, "city"},
+        {Type::Scalar, "Royal Oak"},
+        {Type::MapItem, "sku"},
+        {Type::Scalar, "BL394D"},
+        {Type::MapItem, "sku"},
+        {Type::Scalar, "BL4438H"},
+        {Type::MapItem, "tax"},
+        {Type::Scalar, "251.42"},
+    };
+
+    ASSERT_EQ(std::size(expected), observer.events.size());
+    for (size_t i = 0; i < observer.events.size(); ++i) {
+        ASSERT_EQ(expected[i].first, observer.events[i].getType());
+        ASSERT_EQ(expected[i].second, observer.events[i].getValue());
+    }
+
+    ASSERT_EQ(8, observer.events[0].getSpaces());
+    ASSERT_EQ(input.data() + input.find("Royal Oak"), observer.events[1].getData());
+}
+
+TEST(YamlSelectiveParser, skipSubtreesTest)
+{
+    std::string input;
+    for (int i = 0; i < 1000; ++i) {
+        input += "entry" + std::to_string(i) + ": x\n"
+                 "    a: 1\n"
+                 "\n"
+                 "    b: " + std::to_string(i) + "\n";
+    }
+
+    Fake::EventViewObserver observer;
+    YAML::SelectiveParser parser(&observer);
+    parser.addPath("entry999/b");
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+
+    ASSERT_EQ(2, observer.events.size());
+    ASSERT_EQ("b", observer.events[0].getValue());
+    ASSERT_EQ("999", observer.events[1].getValue());
+    ASSERT_EQ(999 * 3 + 1, parser.getSkippedLines());
+}
+
+TEST(YamlSelectiveParser, subtreeTest)
+{
+    const std::string input("hr: 65\n"
+                            "stats: batting\n"
+                            "    avg: 0.278\n"
+                            "    teams: two\n"
+                            "        - Cardinals\n"
+                            "        - Athletics\n"
+                            "rbi: 147\n"
+                            "    - a b: c\n");
+
+    Fake::EventViewObserver observer;
+    YAML::SelectiveParser parser(&observer);
+    parser.addPath("stats");
+    ASSERT_TRUE(parser.parse(input.data(), input.size()));
+
+    ASSERT_EQ(10, observer.events.size());
+    ASSERT_EQ("stats", observer.events[0].getValue());
+    ASSERT_EQ("batting", observer.events[1].getValue());
+    ASSERT_EQ("Athletics", observer.events[9].getValue());
+    ASSERT_EQ(1, parser.getSkippedLines());
+}
+
+TEST(YamlSelectiveParser, bareKeyParentsTest)
+{
+    // A skipped line may leave the state machine expecting more: the line
+    // after a bare key is its scalar, whatever its indentation
+    expectSameEvents("other: 1\n"
+                     "    x: 1\n"
+                     "    nested:\n"
+                     "wanted: 2\n", {"wanted"});
+
+    expectSameEvents("bill-to:\n"
+                     "    given : Chris\n"
+                     "    address:\n"
+                     "        lines: |\n"
+                     "            458 Walkman Dr.\n"
+                     "            Suite #292\n"
+                     "        city : Royal Oak\n"
+                     "    family : Dumars\n"
+                     "ship-to:\n"
+                     "    list: [a,\n"
+                     "  b]\n"
+                     "    - sku:\n"
+                     "tax : 251.42\n", {"bill-to/address/city", "tax"});
+}
+
+TEST(YamlSelectiveParser, sameEventsAsParserTest)
+{
+    const std::string fragments[] = {"key: value\n", "key:\n", "    key:\n", "    a: 1\n", "        b: 2\n",
+                                     "wanted: 1\n", "    wanted: 2\n", "- \n", "-\n", "    - item\n", "\n",
+                                     "    # comment\n", "    c: 3 # d:\n", "    e: |\n", "    f: >-\n",
+                                     "      text\n", "    g: [1,\n", "    h: {i: 1}\n", "  2]\n", "    'q: r':\n",
+                                     "    k: \"v\"\n"};
+
+    std::mt19937 random(21);
+    for (int i = 0; i < 20000; ++i) {
+        std::string input;
+        for (size_t count = random() % 12; count > 0; --count) {
+            input += fragments[random() % std::size(fragments)];
+        }
+
+        ASSERT_NO_FATAL_FAILURE(expectSameEvents(input, {"wanted"}));
+        ASSERT_NO_FATAL_FAILURE(expectSameEvents(input, {"key/wanted", "other"}));
+    }
+}
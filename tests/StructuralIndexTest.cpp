@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+
+#include "StructuralIndex.h"
+
+namespace {
+
+std::string
+makeInput(size_t length)
+{
+    const char alphabet[] = "ab :#-\r\n\t\v\f\x80\xff";
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<size_t> distribution(0, sizeof(alphabet) - 2);
+
+    std::string result;
+    for (size_t i = 0; i < length; ++i) {
+        result.push_back(alphabet[distribution(generator)]);
+    }
+
+    return result;
+}
+
+bool
+matches(char symbol, unsigned mask)
+{
+    return ((mask & YAML::StructuralIndex::Whitespace) &&
+                (symbol == ' ' || (symbol >= '\t' && symbol <= '\r'))) ||
+        ((mask & YAML::StructuralIndex::Colon) && symbol == ':') ||
+        ((mask & YAML::StructuralIndex::CommentEnd) && (symbol == '#' || symbol == '\r')) ||
+        ((mask & YAML::StructuralIndex::Newline) && symbol == '\n');
+}
+
+}
+
+TEST(YamlStructuralIndex, implementationsMatchReferenceTest)
+{
+    const std::string input = makeInput(1000);
+    const unsigned masks[] = {
+        YAML::StructuralIndex::Whitespace,
+        YAML::StructuralIndex::Colon,
+        YAML::StructuralIndex::CommentEnd,
+        YAML::StructuralIndex::Newline,
+        YAML::StructuralIndex::Whitespace | YAML::StructuralIndex::Colon,
+    };
+    const YAML::StructuralIndex::Implementation implementations[] = {
+        YAML::StructuralIndex::Implementation::Scalar,
+        YAML::StructuralIndex::Implementation::SSE2,
+        YAML::StructuralIndex::Implementation::AVX2,
+    };
+
+    for (auto implementation : implementations) {
+        if (!YAML::StructuralIndex::isSupported(implementation)) {
+            continue;
+        }
+
+        // Odd offsets and lengths exercise the partially filled last block
+        YAML::StructuralIndex index;
+        const char *begin = input.data() + 3;
+        const char *end = input.data() + input.size() - 5;
+        index.build(begin, end, implementation);
+
+        for (unsigned mask : masks) {
+            for (const char *position = begin; position != end; ++position) {
+                const char *expected = position;
+                while (expected != end && !matches(*expected, mask)) {
+                    ++expected;
+                }
+
+                ASSERT_EQ(expected, index.find(position, end, mask));
+            }
+        }
+    }
+}
+
+TEST(YamlStructuralIndex, findStopsAtLimitTest)
+{
+    const std::string input = "key without structurals: value";
+
+    YAML::StructuralIndex index;
+    index.build(input.data(), input.data() + input.size());
+
+    const char *limit = input.data() + 10;
+    ASSERT_EQ(limit, index.find(input.data() + 4, limit, YAML::StructuralIndex::Colon));
+    ASSERT_EQ(input.data() + 23, index.find(input.data(), input.data() + input.size(),
+                YAML::StructuralIndex::Colon));
+    ASSERT_EQ(input.data() + 3, index.find(input.data(), limit, YAML::StructuralIndex::Whitespace));
+}
+
+TEST(YamlStructuralIndex, emptyInputTest)
+{
+    const char *input = "";
+
+    YAML::StructuralIndex index;
+    index.build(input, input);
+    ASSERT_EQ(input, index.find(input, input, YAML::StructuralIndex::Newline));
+}